@@ -20,6 +20,7 @@
 #include <azure/core/az_span.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <azure/core/_az_cfg_prefix.h>
@@ -100,6 +101,19 @@ typedef struct
     /// optimization to avoid redundant checks. It is meaningless for any other token kind.
     bool string_has_escaped_chars;
 
+    /// For number tokens read with #az_json_reader_options.capture_number_values set, a set of
+    /// flags describing the number that was captured while reading it. Otherwise, it is 0.
+    uint8_t number_flags;
+
+    /// For number tokens captured while reading them, the number of digits before the exponent,
+    /// if any, up to a maximum of `UINT8_MAX`.
+    uint8_t number_digit_count;
+
+    /// For number tokens captured while reading them, the power of ten that the digits before the
+    /// exponent scale the number by, including the exponent, if any, clamped to the range of an
+    /// `int16_t`.
+    int16_t number_exponent;
+
     /// This is the first segment in the entire JSON payload, if it was non-contiguous. Otherwise,
     /// its set to #AZ_SPAN_EMPTY.
     az_span* pointer_to_first_buffer;
@@ -115,6 +129,12 @@ typedef struct
 
     /// The offset within the particular segment within which this token ends.
     int32_t end_buffer_offset;
+
+    /// The absolute value of an integer number token, when the \p number_flags indicate that it
+    /// was captured while reading the token. For other numbers captured while reading them, the
+    /// value of their digits before the exponent, ignoring the decimal point, when there are at
+    /// most 19 of them.
+    uint64_t number_magnitude;
   } _internal;
 } az_json_token;
 
@@ -236,6 +256,9 @@ AZ_NODISCARD az_result az_json_token_get_double(az_json_token const* json_token,
  * @retval #AZ_OK The string is returned.
  * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_JSON_TOKEN_STRING.
  * @retval #AZ_ERROR_NOT_ENOUGH_SPACE \p destination does not have enough size.
+ *
+ * @remarks Characters escaped as `\uXXXX`, including surrogate pairs, are written as UTF-8. A
+ * surrogate which isn't part of a pair is written as the replacement character U+FFFD.
  */
 AZ_NODISCARD az_result az_json_token_get_string(
     az_json_token const* json_token,
@@ -255,6 +278,8 @@ AZ_NODISCARD az_result az_json_token_get_string(
  *
  * @remarks This operation is only valid for the string and property name token kinds. For all other
  * token kinds, it returns false.
+ * @remarks The token value is unescaped the same way as by #az_json_token_get_string(), so \p
+ * expected_text should contain UTF-8 rather than `\uXXXX` escapes.
  */
 AZ_NODISCARD bool az_json_token_is_text_equal(
     az_json_token const* json_token,
@@ -267,11 +292,11 @@ AZ_NODISCARD bool az_json_token_is_text_equal(
  */
 typedef struct
 {
-  struct
-  {
-    /// Currently, this is unused, but needed as a placeholder since we can't have an empty struct.
-    bool unused;
-  } _internal;
+  /**
+   * When `true`, the #az_json_writer checks that the strings and property names appended to it are
+   * valid UTF-8, and returns #AZ_ERROR_UNEXPECTED_CHAR without writing them if they aren't.
+   */
+  bool validate_utf8;
 } az_json_writer_options;
 
 /**
@@ -286,9 +311,7 @@ typedef struct
 AZ_NODISCARD AZ_INLINE az_json_writer_options az_json_writer_options_default()
 {
   az_json_writer_options options = (az_json_writer_options) {
-    ._internal = {
-      .unused = false,
-    },
+    .validate_utf8 = false,
   };
 
   return options;
@@ -311,6 +334,7 @@ typedef struct
     int32_t total_bytes_written; // Currently, this is primarily used for testing.
     az_span_allocator_fn allocator_callback;
     void* user_context;
+    bool is_sizing; // When set, the JSON text is only counted, rather than written.
     bool need_comma;
     az_json_token_kind token_kind; // needed for validation, potentially #if/def with preconditions.
     _az_json_bit_stack bit_stack; // needed for validation, potentially #if/def with preconditions.
@@ -363,6 +387,139 @@ AZ_NODISCARD az_result az_json_writer_chunked_init(
     void* user_context,
     az_json_writer_options const* options);
 
+/**
+ * @brief Initializes an #az_json_writer which doesn't write any JSON text, and only counts the
+ * number of bytes that the same sequence of appends would write.
+ *
+ * @param[out] out_json_writer A pointer to an #az_json_writer instance to initialize.
+ * @param[in] options __[nullable]__ A reference to an #az_json_writer_options
+ * structure which defines custom behavior of the #az_json_writer. If `NULL` is passed, the writer
+ * will use the default options (i.e. #az_json_writer_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_writer is initialized successfully.
+ * @retval other Failure.
+ *
+ * @remarks The appends are validated in the same way as when the JSON text is written, but never
+ * fail with #AZ_ERROR_NOT_ENOUGH_SPACE. Once they are done,
+ * #az_json_writer_get_total_bytes_written() gives the exact size, including escaping, of the buffer
+ * needed to write the same JSON text with an #az_json_writer initialized by #az_json_writer_init().
+ */
+AZ_NODISCARD az_result
+az_json_writer_sizing_init(az_json_writer* out_json_writer, az_json_writer_options const* options);
+
+/**
+ * @brief A segment of JSON text written by an #az_json_writer into a chunk of an
+ * #az_json_writer_chunk_pool.
+ *
+ * @remarks The members have the same types and order as those of the POSIX `struct iovec`, so that
+ * an array of segments can be passed to vectored I/O functions such as `writev()`.
+ */
+typedef struct
+{
+  /// The start of the JSON text within the chunk.
+  void* base;
+
+  /// The size of the JSON text within the chunk, in bytes.
+  size_t size;
+} az_json_writer_segment;
+
+/**
+ * @brief A caller-provided pool of buffers, which an #az_json_writer initialized by
+ * #az_json_writer_pooled_init() writes into one after the other, recording the segments of JSON
+ * text it writes.
+ */
+typedef struct
+{
+  struct
+  {
+    az_span* chunks;
+    int32_t number_of_chunks;
+    int32_t next_chunk_index;
+    az_json_writer_segment* segments;
+    int32_t segments_size;
+    int32_t number_of_segments;
+  } _internal;
+} az_json_writer_chunk_pool;
+
+/**
+ * @brief Initializes an #az_json_writer_chunk_pool.
+ *
+ * @param[out] out_chunk_pool A pointer to the #az_json_writer_chunk_pool instance to initialize.
+ * @param[in] chunks The buffers to write the JSON text into, in order. Each must be large enough
+ * for the longest token written, and strings and property names need at least 64 bytes.
+ * @param[in] number_of_chunks The number of elements within \p chunks.
+ * @param[out] segments A caller-provided array which receives the segments of JSON text.
+ * @param[in] segments_size The number of elements within \p segments, which must be at least
+ * \p number_of_chunks so that every chunk can be used.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The chunk pool was initialized successfully.
+ */
+AZ_NODISCARD az_result az_json_writer_chunk_pool_init(
+    az_json_writer_chunk_pool* out_chunk_pool,
+    az_span chunks[],
+    int32_t number_of_chunks,
+    az_json_writer_segment segments[],
+    int32_t segments_size);
+
+/**
+ * @brief Initializes an #az_json_writer which writes JSON text into the chunks of a pool, moving to
+ * the next chunk whenever the next token doesn't fit within the current one.
+ *
+ * @param[out] out_json_writer A pointer to the #az_json_writer instance to initialize.
+ * @param[in,out] ref_chunk_pool A pointer to the #az_json_writer_chunk_pool to take chunks from,
+ * which must outlive the writer, and have at least one chunk left.
+ * @param[in] options __[nullable]__ A reference to an #az_json_writer_options
+ * structure which defines custom behavior of the #az_json_writer. If `NULL` is passed, the writer
+ * will use the default options (i.e. #az_json_writer_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_writer is initialized successfully.
+ *
+ * @remarks The writer returns #AZ_ERROR_NOT_ENOUGH_SPACE once the pool has no chunk left that is
+ * large enough for the next token.
+ */
+AZ_NODISCARD az_result az_json_writer_pooled_init(
+    az_json_writer* out_json_writer,
+    az_json_writer_chunk_pool* ref_chunk_pool,
+    az_json_writer_options const* options);
+
+/**
+ * @brief Records the JSON text written into the last chunk as the final segment, once the writer
+ * has finished writing.
+ *
+ * @param[in,out] ref_chunk_pool A pointer to the #az_json_writer_chunk_pool that the writer wrote
+ * into.
+ * @param[in] json_writer A pointer to the #az_json_writer initialized by
+ * #az_json_writer_pooled_init().
+ * @param[out] out_number_of_segments The number of segments of JSON text, in order, at the start of
+ * the segments array of the pool.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The segments were recorded successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The segments array of the pool is too small.
+ */
+AZ_NODISCARD az_result az_json_writer_chunk_pool_get_segments(
+    az_json_writer_chunk_pool* ref_chunk_pool,
+    az_json_writer const* json_writer,
+    int32_t* out_number_of_segments);
+
+/**
+ * @brief Returns the number of bytes of JSON text appended so far, across all of the destination
+ * buffers.
+ *
+ * @param[in] json_writer A pointer to an #az_json_writer instance.
+ *
+ * @return The number of bytes of JSON text appended so far. For an #az_json_writer initialized by
+ * #az_json_writer_sizing_init(), this is the number of bytes that would have been written.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+az_json_writer_get_total_bytes_written(az_json_writer const* json_writer)
+{
+  return json_writer->_internal.total_bytes_written;
+}
+
 /**
  * @brief Returns the #az_span containing the JSON text written to the underlying buffer so far, in
  * the last provided destination buffer.
@@ -387,6 +544,79 @@ az_json_writer_get_bytes_used_in_destination(az_json_writer const* json_writer)
       json_writer->_internal.destination_buffer, 0, json_writer->_internal.bytes_written);
 }
 
+/**
+ * @brief The state of an #az_json_writer at a point in the JSON text, which the writer can be
+ * rolled back to with #az_json_writer_rollback().
+ */
+typedef struct
+{
+  struct
+  {
+    az_span destination_buffer;
+    int32_t bytes_written;
+    int32_t total_bytes_written;
+    bool need_comma;
+    az_json_token_kind token_kind;
+    _az_json_bit_stack bit_stack;
+  } _internal;
+} az_json_writer_checkpoint;
+
+/**
+ * @brief Saves the current state of the writer: its position within the destination buffer, the
+ * nesting of objects and arrays, and whether a comma separator is needed next.
+ *
+ * @param[in] json_writer A pointer to an #az_json_writer instance.
+ *
+ * @return An #az_json_writer_checkpoint, which can be passed to #az_json_writer_rollback().
+ */
+AZ_NODISCARD az_json_writer_checkpoint
+az_json_writer_get_checkpoint(az_json_writer const* json_writer);
+
+/**
+ * @brief Restores the state of the writer saved by #az_json_writer_get_checkpoint(), discarding
+ * any JSON text written since then, including the partial text of an append that failed.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance.
+ * @param[in] checkpoint A pointer to the #az_json_writer_checkpoint to restore.
+ *
+ * @remarks The writer must still be writing into the same destination buffer as when the
+ * checkpoint was saved, and not have been flushed by #az_json_writer_flush() since then.
+ */
+void az_json_writer_rollback(
+    az_json_writer* ref_json_writer,
+    az_json_writer_checkpoint const* checkpoint);
+
+/**
+ * @brief Returns the JSON text written into the destination buffer so far, and then continues
+ * writing from the start of the same buffer, so that the JSON text can be written a piece at a
+ * time through a small buffer.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance.
+ * @param[out] out_json_text A pointer to an #az_span which receives the JSON text written since the
+ * last flush, which must be consumed (for example, sent) before appending anything else.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON text was flushed successfully.
+ *
+ * @remarks The nesting of objects and arrays, and whether a comma separator is needed next, carry
+ * on as if the text was still in the buffer. Combined with a checkpoint, this lets a writer stream
+ * a document of any size through a buffer which only needs to hold its largest token:
+ *
+ * \code{.c}
+ * az_json_writer_checkpoint checkpoint = az_json_writer_get_checkpoint(&writer);
+ * az_result result = az_json_writer_append_string(&writer, value);
+ * if (result == AZ_ERROR_NOT_ENOUGH_SPACE)
+ * {
+ *   az_json_writer_rollback(&writer, &checkpoint);
+ *   az_span json_text = AZ_SPAN_EMPTY;
+ *   result = az_json_writer_flush(&writer, &json_text);
+ *   // Send json_text, and then append the string again.
+ * }
+ * \endcode
+ */
+AZ_NODISCARD az_result
+az_json_writer_flush(az_json_writer* ref_json_writer, az_span* out_json_text);
+
 /**
  * @brief Appends the UTF-8 text value (as a JSON string) into the buffer.
  *
@@ -400,6 +630,8 @@ az_json_writer_get_bytes_used_in_destination(az_json_writer const* json_writer)
  * @return An #az_result value indicating the result of the operation.
  * @retval #AZ_OK The string value was appended successfully.
  * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR \p value isn't valid UTF-8, and the writer was initialized
+ * with #az_json_writer_options.validate_utf8 set.
  */
 AZ_NODISCARD az_result az_json_writer_append_string(az_json_writer* ref_json_writer, az_span value);
 
@@ -445,10 +677,84 @@ az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_te
  * @return An #az_result value indicating the result of the operation.
  * @retval #AZ_OK The property name was appended successfully.
  * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR \p name isn't valid UTF-8, and the writer was initialized
+ * with #az_json_writer_options.validate_utf8 set.
  */
 AZ_NODISCARD az_result
 az_json_writer_append_property_name(az_json_writer* ref_json_writer, az_span name);
 
+/**
+ * @brief A property name that has been escaped and quoted ahead of time, so that it can be appended
+ * by #az_json_writer_append_prepared_property_name() with a single copy.
+ *
+ * @remarks Initialize it with #az_json_prepared_property_name_init(), or with
+ * #AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR() for a literal name which doesn't contain any
+ * characters that need to be escaped.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The leading comma separator, followed by the quoted, escaped name, and the colon which
+    /// separates it from its value.
+    az_span text;
+  } _internal;
+} az_json_prepared_property_name;
+
+/**
+ * @brief Returns an #az_json_prepared_property_name for a literal property name, which doesn't
+ * contain any `"`, `\`, or control characters that need to be escaped.
+ *
+ * For example:
+ *
+ * `static az_json_prepared_property_name const temperature_name =
+ * AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR("temperature");`
+ */
+#define AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR(STRING_LITERAL) \
+  {                                                                     \
+    ._internal = {                                                      \
+      .text = AZ_SPAN_LITERAL_FROM_STR(",\"" STRING_LITERAL "\":"),     \
+    },                                                                  \
+  }
+
+/**
+ * @brief Escapes and quotes the UTF-8 \p name once, within \p buffer, so that it can be appended
+ * with #az_json_writer_append_prepared_property_name() as often as needed.
+ *
+ * @param[out] out_property_name A pointer to the #az_json_prepared_property_name instance to
+ * initialize.
+ * @param[in] name The UTF-8 encoded property name.
+ * @param[in] buffer The buffer which receives the escaped property name. It must be at least 4
+ * bytes larger than the escaped \p name, and must outlive \p out_property_name.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property name was prepared successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE \p buffer is too small.
+ */
+AZ_NODISCARD az_result az_json_prepared_property_name_init(
+    az_json_prepared_property_name* out_property_name,
+    az_span name,
+    az_span buffer);
+
+/**
+ * @brief Appends a property name, which was escaped and quoted ahead of time, as the first part of
+ * a name/value pair of a JSON object.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the property name to.
+ * @param[in] property_name A pointer to the #az_json_prepared_property_name to append.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property name was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remarks The property name isn't escaped or validated again, not even when the writer was
+ * initialized with #az_json_writer_options.validate_utf8 set.
+ */
+AZ_NODISCARD az_result az_json_writer_append_prepared_property_name(
+    az_json_writer* ref_json_writer,
+    az_json_prepared_property_name const* property_name);
+
 /**
  * @brief Appends a boolean value (as a JSON literal `true` or `false`).
  *
@@ -475,6 +781,22 @@ AZ_NODISCARD az_result az_json_writer_append_bool(az_json_writer* ref_json_write
  */
 AZ_NODISCARD az_result az_json_writer_append_int32(az_json_writer* ref_json_writer, int32_t value);
 
+/**
+ * @brief Appends an `int64_t` number value.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remark Numbers larger in magnitude than `2^53` are written exactly, but can lose precision when
+ * read by JSON parsers which store every number as a `double`.
+ */
+AZ_NODISCARD az_result az_json_writer_append_int64(az_json_writer* ref_json_writer, int64_t value);
+
 /**
  * @brief Appends a `double` number value.
  *
@@ -504,6 +826,28 @@ AZ_NODISCARD az_result az_json_writer_append_double(
     double value,
     int32_t fractional_digits);
 
+/**
+ * @brief Appends a `double` number value, using the fewest digits which parse back to the same
+ * `double`.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remark Only finite double values are supported. Values such as `NAN` and `INFINITY` are not
+ * allowed and would lead to invalid JSON being written.
+ *
+ * @remark The number is formatted with #az_span_dtoa_shortest(), so, unlike
+ * #az_json_writer_append_double(), no precision is lost and the whole range of finite `double`
+ * values is supported. For example, `0.1` is written as `0.1` and `1e300` as `1e+300`.
+ */
+AZ_NODISCARD az_result
+az_json_writer_append_double_shortest(az_json_writer* ref_json_writer, double value);
+
 /**
  * @brief Appends the JSON literal `null`.
  *
@@ -575,11 +919,34 @@ AZ_NODISCARD az_result az_json_writer_append_end_array(az_json_writer* ref_json_
  */
 typedef struct
 {
-  struct
-  {
-    /// Currently, this is unused, but needed as a placeholder since we can't have an empty struct.
-    bool unused;
-  } _internal;
+  /**
+   * When `true`, #az_json_reader_skip_children() finds the end of an object or array by only
+   * tracking the nesting depth and which bytes are within strings, a block at a time, rather than
+   * reading every nested token.
+   *
+   * @remarks The JSON text that is skipped is not validated, so an invalid nested value doesn't
+   * cause an error. The reader is still left on the matching end of the object or array.
+   */
+  bool skip_children_without_validation;
+
+  /**
+   * When `true`, the #az_json_reader also checks that the bytes of every string and property name
+   * are valid UTF-8, while it looks for the end of each of them, and returns
+   * #AZ_ERROR_UNEXPECTED_CHAR if they aren't.
+   */
+  bool validate_utf8;
+
+  /**
+   * When `true`, the #az_json_reader records whether each number it reads is an integer, its sign,
+   * its number of digits, and the value of numbers with up to 19 digits, while it looks for the end
+   * of the number. The #az_json_token_get_int32(), #az_json_token_get_int64(),
+   * #az_json_token_get_uint32(), #az_json_token_get_uint64(), and #az_json_token_get_double()
+   * functions then use that instead of parsing the JSON text of the token again.
+   *
+   * @remarks The values returned by those functions are identical to those returned without this
+   * option.
+   */
+  bool capture_number_values;
 } az_json_reader_options;
 
 /**
@@ -594,9 +961,9 @@ typedef struct
 AZ_NODISCARD AZ_INLINE az_json_reader_options az_json_reader_options_default()
 {
   az_json_reader_options options = (az_json_reader_options) {
-    ._internal = {
-      .unused = false,
-    },
+    .skip_children_without_validation = false,
+    .validate_utf8 = false,
+    .capture_number_values = false,
   };
 
   return options;
@@ -735,6 +1102,1216 @@ AZ_NODISCARD az_result az_json_reader_next_token(az_json_reader* ref_json_reader
  */
 AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_reader);
 
+/**
+ * @brief Finds the values of a set of JSON pointer paths within the current JSON value, in a single
+ * forward pass.
+ *
+ * @param[in,out] ref_json_reader A pointer to an #az_json_reader instance containing the JSON to
+ * read.
+ * @param[in] paths An array of JSON pointer paths (as defined by RFC 6901), such as
+ * `/desired/$version` or `/items/0/name`.
+ * @param[in] number_of_paths The number of paths within the \p paths array. It must be between 1
+ * and 16.
+ * @param[out] out_tokens An array of \p number_of_paths tokens. Each token is set to the value
+ * found at the corresponding path, or has the kind #AZ_JSON_TOKEN_NONE if the path wasn't found.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON value was read successfully, whether or not every path was found.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON document is reached.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ *
+ * @remarks The paths are relative to the current JSON value. If the current token kind is none
+ * (i.e. nothing has been read yet), the reader first moves to the first token. If it is a property
+ * name, the reader first moves to the property value. An empty path refers to that value itself.
+ *
+ * @remarks Nested objects and arrays which cannot contain any of the remaining paths are skipped
+ * without being compared. The reader stops as soon as every path has either been found or can no
+ * longer be found, or at the end of the current JSON value, whichever comes first. Use a copy of
+ * the #az_json_reader to continue reading from the current position afterwards.
+ *
+ * @remarks If a property name appears more than once, only its first occurrence is matched, so a
+ * path which isn't found within the value of that occurrence isn't looked for within the others.
+ * Within a path segment, `~1` stands for `/` and `~0` stands for `~`. Segments containing such
+ * escapes which are longer than 64 bytes never match any property. When the value found is an
+ * object or an array, the token returned is its #AZ_JSON_TOKEN_BEGIN_OBJECT or
+ * #AZ_JSON_TOKEN_BEGIN_ARRAY token.
+ */
+AZ_NODISCARD az_result az_json_reader_find_paths(
+    az_json_reader* ref_json_reader,
+    az_span const paths[],
+    int32_t number_of_paths,
+    az_json_token out_tokens[]);
+
+/**
+ * @brief A position within JSON text read by an #az_json_reader, from which reading can later be
+ * resumed, without keeping a copy of the whole reader.
+ *
+ * @remarks A cursor only records offsets within the JSON text, the current token kind, and the
+ * nesting of the objects and arrays around it, so it is small enough to be stored, or passed by
+ * value, in place of an #az_json_reader.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The offset within the JSON text of the slice of the current token.
+    int32_t token_offset;
+
+    /// The size of the slice of the current token.
+    int32_t token_size;
+
+    /// The number of bytes of the JSON text consumed by the reader.
+    int32_t bytes_consumed;
+
+    /// The nesting of the objects and arrays around the current token.
+    _az_json_bit_stack bit_stack;
+
+    // Avoid using enum as the first field within structs, to allow for { 0 } initialization.
+
+    /// The kind of the current token.
+    az_json_token_kind token_kind;
+
+    /// Whether the current token is a string which contains escaped characters.
+    bool string_has_escaped_chars;
+
+    /// Whether the JSON text is an object or array, rather than a single primitive token.
+    bool is_complex_json;
+  } _internal;
+} az_json_cursor;
+
+/**
+ * @brief Returns a cursor recording the current position of an #az_json_reader.
+ *
+ * @param[in] json_reader A pointer to an #az_json_reader instance over a single, contiguous buffer.
+ *
+ * @return An #az_json_cursor from which #az_json_reader_init_at_cursor() resumes reading at the
+ * current token of the \p json_reader.
+ */
+AZ_NODISCARD az_json_cursor az_json_reader_get_cursor(az_json_reader const* json_reader);
+
+/**
+ * @brief Initializes an #az_json_reader to resume reading JSON text at a cursor, in constant time.
+ *
+ * @param[out] out_json_reader A pointer to an #az_json_reader instance to initialize.
+ * @param[in] json_buffer An #az_span over the byte buffer containing the JSON text, which must be
+ * the same one as read when the \p cursor was returned by #az_json_reader_get_cursor().
+ * @param[in] cursor A pointer to the #az_json_cursor to resume reading at.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the #az_json_reader. If `NULL` is passed, the reader will use the
+ * default options (i.e. #az_json_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_reader is initialized successfully.
+ *
+ * @remarks The current token of the reader is the one it had when the cursor was returned, so it
+ * can be read without moving the reader, and the next token is the one that followed it. Numbers
+ * captured while reading, as set by #az_json_reader_options.capture_number_values, are parsed
+ * again from the token slice instead.
+ */
+AZ_NODISCARD az_result az_json_reader_init_at_cursor(
+    az_json_reader* out_json_reader,
+    az_span json_buffer,
+    az_json_cursor const* cursor,
+    az_json_reader_options const* options);
+
+/************************************ JSON PUSH READER ******************/
+
+/**
+ * @brief Returns the JSON tokens contained within JSON text that is provided a fragment at a time,
+ * as it arrives, rather than all at once.
+ *
+ * @remarks Only the bytes of a token that straddles the end of a fragment are kept, within a
+ * caller-provided carry-over buffer. The token field is meant to be used as read-only. Do NOT
+ * modify it.
+ */
+typedef struct
+{
+  /// This read-only field gives access to the current token that the #az_json_push_reader has
+  /// processed, and it shouldn't be modified by the caller.
+  az_json_token token;
+
+  struct
+  {
+    /// The reader over the carried-over bytes followed by the current fragment.
+    az_json_reader reader;
+
+    /// The carried-over bytes of the previous fragments (if any) and the current fragment.
+    az_span segments[2];
+
+    /// The caller-provided buffer used to keep the unread bytes of the previous fragments.
+    az_span carry_buffer;
+
+    /// The unread bytes copied into the carry-over buffer once the text provided so far ended
+    /// before the next token, which become the start of the text when the next fragment is
+    /// provided.
+    az_span carried;
+
+    /// A copy of the options provided by the user.
+    az_json_reader_options options;
+
+    /// Flag which indicates that at least one fragment has been provided.
+    bool has_fragment;
+
+    /// Flag which indicates that the unread bytes have been carried over, and that nothing more
+    /// can be read until the next fragment is provided.
+    bool has_carried;
+
+    /// Flag which indicates that the current fragment is the last one.
+    bool is_final_fragment;
+  } _internal;
+} az_json_push_reader;
+
+/**
+ * @brief Initializes an #az_json_push_reader to read JSON text provided a fragment at a time.
+ *
+ * @param[out] out_json_push_reader A pointer to an #az_json_push_reader instance to initialize.
+ * @param[in] carry_buffer An #az_span over a byte buffer used to keep the bytes of a token which
+ * straddles the end of a fragment, until the next fragment is provided. It must be large enough for
+ * the starts of two such tokens, since the start of the previous one is kept until then too.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the #az_json_push_reader. If `NULL` is passed, the reader will use the
+ * default options (i.e. #az_json_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_push_reader is initialized successfully.
+ */
+AZ_NODISCARD az_result az_json_push_reader_init(
+    az_json_push_reader* out_json_push_reader,
+    az_span carry_buffer,
+    az_json_reader_options const* options);
+
+/**
+ * @brief Provides the next fragment of the JSON text to an #az_json_push_reader.
+ *
+ * @param[in,out] ref_json_push_reader A pointer to an #az_json_push_reader instance.
+ * @param[in] fragment An #az_span over the next bytes of the JSON text. It can be empty, which is
+ * useful to indicate that the previous fragment was the last one.
+ * @param[in] is_final_fragment `true` if there is no more JSON text after this \p fragment.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The fragment was provided successfully.
+ *
+ * @remarks Call this only once #az_json_push_reader_next_token() returns #AZ_ERROR_UNEXPECTED_END,
+ * at which point the unread bytes of the previous fragments have been copied into the carry-over
+ * buffer. The buffer of the previous fragment can therefore be reused for the \p fragment, which
+ * must remain valid until #az_json_push_reader_next_token() next returns
+ * #AZ_ERROR_UNEXPECTED_END. The tokens returned before this is called must no longer be used.
+ */
+AZ_NODISCARD az_result az_json_push_reader_feed(
+    az_json_push_reader* ref_json_push_reader,
+    az_span fragment,
+    bool is_final_fragment);
+
+/**
+ * @brief Reads the next token in the JSON text provided so far and updates the reader state.
+ *
+ * @param[in,out] ref_json_push_reader A pointer to an #az_json_push_reader instance.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The token was read successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_END The JSON text provided so far ends before the next token is
+ * complete. Unless the last fragment was already provided, call #az_json_push_reader_feed() with
+ * the next fragment and then call this again.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The start of the incomplete token doesn't fit within the
+ * carry-over buffer.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ * @retval #AZ_ERROR_JSON_READER_DONE No more JSON text left to process.
+ *
+ * @remarks When the next token is incomplete, the reader state is left unchanged, other than the
+ * unread bytes being copied into the carry-over buffer. The tokens returned before then remain
+ * valid until the buffer of the current fragment is reused, or the next fragment is provided,
+ * whichever comes first, so that a property name can still be used once the text of its value
+ * runs out.
+ *
+ * @remarks A number at the very end of a fragment is only returned once the following byte or the
+ * last fragment has been provided, since more of its digits could still follow.
+ */
+AZ_NODISCARD az_result az_json_push_reader_next_token(az_json_push_reader* ref_json_push_reader);
+
+/************************************ JSON DOCUMENT ******************/
+
+/**
+ * @brief A compact record of a single token within an #az_json_document.
+ *
+ * @remarks The caller provides the storage for the records, but their fields are meant to be used
+ * only by the #az_json_document functions.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The offset of the token within the JSON buffer. In the case of JSON strings, it doesn't
+    /// include the opening quote.
+    int32_t offset;
+
+    /// The size of the JSON text that represents the token value.
+    int32_t size;
+
+    /// For the start of an object or array, the index of the record of its end, and for the end of
+    /// an object or array, the index of the record of its start. Otherwise, -1.
+    int32_t link_index;
+
+    /// The index of the record of the start of the enclosing object or array, or -1 at the root.
+    int32_t parent_index;
+
+    /// The #az_json_token_kind of the token.
+    uint8_t kind;
+
+    /// A flag to indicate whether the JSON string contained any escaped characters.
+    bool string_has_escaped_chars;
+  } _internal;
+} az_json_document_record;
+
+/**
+ * @brief A JSON text that has been read once into an array of #az_json_document_record, so that
+ * its tokens can be revisited in any order without reading the JSON text again.
+ *
+ * @remarks Tokens are referred to by their index, in the order they appear within the JSON text.
+ * The root JSON value is at index 0. Within an object, the record of a property name is
+ * immediately followed by the record of its value.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The buffer containing the JSON text.
+    az_span json_buffer;
+
+    /// The records of the tokens within the JSON text.
+    az_json_document_record* records;
+
+    /// The number of records used to store the tokens of the JSON text.
+    int32_t number_of_records;
+  } _internal;
+} az_json_document;
+
+/**
+ * @brief Reads the JSON text contained within the provided buffer into an #az_json_document.
+ *
+ * @param[out] out_json_document A pointer to an #az_json_document instance to initialize.
+ * @param[in] json_buffer An #az_span over the byte buffer containing the JSON text to read.
+ * @param[out] records An array of records to store the tokens of the JSON text in. One record is
+ * needed for every token, including property names and the ends of objects and arrays.
+ * @param[in] records_size The number of elements within the \p records array.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the #az_json_reader used to read the JSON text. If `NULL` is passed,
+ * the default options are used (i.e. #az_json_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON text was read successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE There are more tokens than \p records_size.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON document is reached.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ *
+ * @remarks An instance of #az_json_document must not outlive the lifetime of the JSON payload
+ * within the \p json_buffer, or of the \p records.
+ */
+AZ_NODISCARD az_result az_json_document_parse(
+    az_json_document* out_json_document,
+    az_span json_buffer,
+    az_json_document_record records[],
+    int32_t records_size,
+    az_json_reader_options const* options);
+
+/**
+ * @brief Gets the number of tokens within an #az_json_document.
+ *
+ * @param[in] json_document A pointer to an #az_json_document instance.
+ *
+ * @return The number of tokens, which is also the number of records used.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+az_json_document_get_token_count(az_json_document const* json_document)
+{
+  return json_document->_internal.number_of_records;
+}
+
+/**
+ * @brief Gets the token at the given index within an #az_json_document.
+ *
+ * @param[in] json_document A pointer to an #az_json_document instance.
+ * @param[in] index The index of the token, less than #az_json_document_get_token_count().
+ *
+ * @return The #az_json_token, identical to the one returned by the #az_json_reader.
+ */
+AZ_NODISCARD az_json_token
+az_json_document_get_token(az_json_document const* json_document, int32_t index);
+
+/**
+ * @brief Gets the index of the start of the object or array which contains the token at the given
+ * index.
+ *
+ * @param[in] json_document A pointer to an #az_json_document instance.
+ * @param[in] index The index of the token, less than #az_json_document_get_token_count().
+ * @param[out] out_index The index of the #AZ_JSON_TOKEN_BEGIN_OBJECT or #AZ_JSON_TOKEN_BEGIN_ARRAY
+ * token of the parent.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The parent was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND The token is the root JSON value, which has no parent.
+ *
+ * @remarks The parent of both a property name and its value is the object containing them.
+ */
+AZ_NODISCARD az_result az_json_document_get_parent(
+    az_json_document const* json_document,
+    int32_t index,
+    int32_t* out_index);
+
+/**
+ * @brief Gets the index of the first property name of an object, or the first element of an
+ * array.
+ *
+ * @param[in] json_document A pointer to an #az_json_document instance.
+ * @param[in] index The index of an #AZ_JSON_TOKEN_BEGIN_OBJECT or #AZ_JSON_TOKEN_BEGIN_ARRAY token.
+ * @param[out] out_index The index of the first property name or array element.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The first child was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND The object or array is empty.
+ */
+AZ_NODISCARD az_result az_json_document_get_first_child(
+    az_json_document const* json_document,
+    int32_t index,
+    int32_t* out_index);
+
+/**
+ * @brief Gets the index of the next property name of an object, or the next element of an array,
+ * skipping over any nested objects and arrays.
+ *
+ * @param[in] json_document A pointer to an #az_json_document instance.
+ * @param[in] index The index of a property name or property value within an object, or of an
+ * element of an array.
+ * @param[out] out_index The index of the next property name or array element.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The next sibling was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND It is the last property or element of its parent, or the root
+ * JSON value.
+ */
+AZ_NODISCARD az_result az_json_document_get_next_sibling(
+    az_json_document const* json_document,
+    int32_t index,
+    int32_t* out_index);
+
+/**
+ * @brief Finds the value of the property with the given name, within an object.
+ *
+ * @param[in] json_document A pointer to an #az_json_document instance.
+ * @param[in] index The index of an #AZ_JSON_TOKEN_BEGIN_OBJECT token.
+ * @param[in] property_name The unescaped name of the property to find.
+ * @param[out] out_index The index of the value of the first property with the given name.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND The object doesn't contain a property with that name.
+ *
+ * @remarks Only the direct properties of the object are compared, and their nested objects and
+ * arrays are skipped without being read.
+ */
+AZ_NODISCARD az_result az_json_document_find_property(
+    az_json_document const* json_document,
+    int32_t index,
+    az_span property_name,
+    int32_t* out_index);
+
+/************************************ JSON BIND ******************/
+
+/**
+ * @brief The C type of a struct member bound to a JSON property by an #az_json_bind_field.
+ */
+typedef enum
+{
+  AZ_JSON_BIND_BOOLEAN = 1, ///< A `bool`, bound to `true` or `false`.
+  AZ_JSON_BIND_INT32 = 2, ///< An `int32_t`, bound to a number.
+  AZ_JSON_BIND_UINT32 = 3, ///< A `uint32_t`, bound to a number.
+  AZ_JSON_BIND_INT64 = 4, ///< An `int64_t`, bound to a number.
+  AZ_JSON_BIND_DOUBLE = 5, ///< A `double`, bound to a number.
+
+  /// An #az_json_bind_string, bound to a string.
+  AZ_JSON_BIND_STRING = 6,
+} az_json_bind_type;
+
+/**
+ * @brief A struct member bound to a JSON string, as an #AZ_JSON_BIND_STRING field.
+ *
+ * @remarks The buffer is kept apart from the length of the string within it, so that the same
+ * struct can be read into any number of times, each string using as much of the buffer as it needs.
+ */
+typedef struct
+{
+  /// A caller-provided buffer which receives the unescaped string, followed by a null terminator,
+  /// when reading.
+  az_span buffer;
+
+  /// The length of the string at the start of \p buffer, which is set when reading, and written
+  /// from when writing.
+  int32_t length;
+} az_json_bind_string;
+
+enum
+{
+  /// A number of fractional digits for #AZ_JSON_BIND_DOUBLE values, which writes the shortest text
+  /// that reads back as the same value, as by #az_json_writer_append_double_shortest().
+  AZ_JSON_BIND_DOUBLE_SHORTEST = -1,
+};
+
+/**
+ * @brief Describes how a single JSON property is bound to a member of a C struct, by
+ * #az_json_bind_read() and #az_json_bind_write().
+ *
+ * @remarks An array of fields describing a struct is typically declared once, as a `static const`
+ * table, using `offsetof` for the offsets.
+ */
+typedef struct
+{
+  /// The unescaped name of the JSON property.
+  az_span name;
+
+  /// The C type of the struct member.
+  az_json_bind_type type;
+
+  /// The offset of the member within the struct, in bytes.
+  int32_t offset;
+
+  /// For #AZ_JSON_BIND_DOUBLE, the number of digits to write after the decimal point, as by
+  /// #az_json_writer_append_double(), or #AZ_JSON_BIND_DOUBLE_SHORTEST.
+  int32_t fractional_digits;
+
+  /// Whether #az_json_bind_read() fails if the JSON object doesn't contain the property.
+  bool required;
+} az_json_bind_field;
+
+enum
+{
+  /// The number of fields that can be bound to the properties of a single JSON object, one for each
+  /// bit of the mask that tracks which of them were found.
+  _az_JSON_BIND_MAX_FIELDS = 32,
+
+  /// The number of slots in the index of an #az_json_bind_table, a power of two with room for twice
+  /// the number of fields, so that looking a name up only probes a few of them.
+  _az_JSON_BIND_TABLE_SLOTS = 2 * _az_JSON_BIND_MAX_FIELDS,
+};
+
+/**
+ * @brief A table of #az_json_bind_field, indexed by the hashes of their names, which describes a
+ * struct to both #az_json_bind_read() and #az_json_bind_write().
+ *
+ * @remarks Initialize it once with #az_json_bind_table_init(), and reuse it for every read and
+ * write.
+ */
+typedef struct
+{
+  struct
+  {
+    az_json_bind_field const* fields;
+    int32_t number_of_fields;
+
+    // A bit for each field which #az_json_bind_read() fails without.
+    uint32_t required_fields;
+
+    // The hash of the name of each field, in the same order as the fields, which is compared before
+    // the name itself when looking a name up.
+    uint32_t hashes[_az_JSON_BIND_MAX_FIELDS];
+
+    // One more than the index of the field within each slot of the open addressing index, or 0 if
+    // the slot is empty.
+    int8_t slots[_az_JSON_BIND_TABLE_SLOTS];
+  } _internal;
+} az_json_bind_table;
+
+/**
+ * @brief Initializes an #az_json_bind_table, hashing the names of the fields, so that reading
+ * doesn't need to hash them again.
+ *
+ * @param[out] out_table A pointer to an #az_json_bind_table instance to initialize.
+ * @param[in] fields The fields describing the properties to bind, which must have unique names.
+ * They must remain valid for as long as the table is used.
+ * @param[in] number_of_fields The number of elements within \p fields, at least 1.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The table was initialized successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE There are more than 32 fields.
+ * @retval #AZ_ERROR_ARG Two of the fields have the same name.
+ */
+AZ_NODISCARD az_result az_json_bind_table_init(
+    az_json_bind_table* out_table,
+    az_json_bind_field const fields[],
+    int32_t number_of_fields);
+
+/**
+ * @brief Reads a JSON object into the members of a C struct, as described by a table of fields, in
+ * a single pass over the JSON text.
+ *
+ * @param[in,out] ref_json_reader A pointer to an #az_json_reader instance, positioned on the
+ * #AZ_JSON_TOKEN_BEGIN_OBJECT token of the object, or not having read any token yet.
+ * @param[in] table A pointer to an #az_json_bind_table of the fields describing the properties to
+ * bind, initialized by #az_json_bind_table_init().
+ * @param[out] out_struct A pointer to the struct to read the property values into.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The object was read, and the reader is positioned on its
+ * #AZ_JSON_TOKEN_END_OBJECT token.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The JSON value is not an object, or a property value doesn't
+ * match the type of its field.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND A required property is missing from the object.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE A string, along with its null terminator, doesn't fit within
+ * the buffer of its #az_json_bind_string member.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected, or a number doesn't fit
+ * within the type of its field.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON text is reached.
+ *
+ * @remarks Each property name is hashed and looked up in the index of \p table, rather than
+ * compared with every field. Names containing escapes, or split across the buffers of a
+ * multi-segment reader, are compared with each field instead. Properties without a field are
+ * skipped, along with any nested objects and arrays, and members without a matching property are
+ * left unchanged.
+ */
+AZ_NODISCARD az_result az_json_bind_read(
+    az_json_reader* ref_json_reader,
+    az_json_bind_table const* table,
+    void* out_struct);
+
+/**
+ * @brief Writes the members of a C struct as a JSON object, as described by a table of fields.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance, in a state where a value
+ * can be appended.
+ * @param[in] table A pointer to an #az_json_bind_table of the fields describing the properties to
+ * write, initialized by #az_json_bind_table_init(). The properties are written in the order of
+ * its fields.
+ * @param[in] value_struct A pointer to the struct to write the property values from.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The object was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_json_bind_write(
+    az_json_writer* ref_json_writer,
+    az_json_bind_table const* table,
+    void const* value_struct);
+
+/************************************ JSON TEMPLATE ******************/
+
+/**
+ * @brief A value slot within an #az_json_template, which is filled in each time JSON is written
+ * from the template.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The offset of the placeholder value within the template text.
+    int32_t start;
+
+    /// The offset just past the end of the placeholder value within the template text.
+    int32_t end;
+
+    /// For #AZ_JSON_BIND_DOUBLE, the number of digits to write after the decimal point, or
+    /// #AZ_JSON_BIND_DOUBLE_SHORTEST.
+    int32_t fractional_digits;
+
+    /// The #az_json_bind_type of the values written into the slot.
+    uint8_t type;
+  } _internal;
+} az_json_template_slot;
+
+/**
+ * @brief JSON text of a fixed shape, built once with an #az_json_writer, with typed slots for the
+ * values that change each time JSON is written from it.
+ *
+ * @remarks Build the template by appending the fixed parts of the JSON to the writer returned by
+ * #az_json_template_get_writer(), and by calling #az_json_template_append_slot() where a value
+ * changes each time. Then write JSON from it using an #az_json_template_writer, which only copies
+ * the fixed parts and formats the slot values.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The writer used to build the template text, which must be complete JSON before the template
+    /// is used by an #az_json_template_writer.
+    az_json_writer writer;
+
+    az_json_template_slot* slots;
+    int32_t slots_size;
+    int32_t number_of_slots;
+  } _internal;
+} az_json_template;
+
+/**
+ * @brief Initializes an #az_json_template, before its text is built.
+ *
+ * @param[out] out_json_template A pointer to the #az_json_template instance to initialize.
+ * @param[in] template_buffer The buffer which receives the template text.
+ * @param[in] slots A caller-provided array which receives the value slots of the template.
+ * @param[in] slots_size The number of elements within \p slots.
+ * @param[in] options __[nullable]__ A reference to an #az_json_writer_options structure, used by
+ * the writer of the template, and when writing slot values. If `NULL` is passed, the writer will
+ * use the default options.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The template was initialized successfully.
+ */
+AZ_NODISCARD az_result az_json_template_init(
+    az_json_template* out_json_template,
+    az_span template_buffer,
+    az_json_template_slot slots[],
+    int32_t slots_size,
+    az_json_writer_options const* options);
+
+/**
+ * @brief Returns the writer used to build the text of an #az_json_template, to which the fixed
+ * parts of the JSON are appended.
+ *
+ * @param[in] ref_json_template A pointer to the #az_json_template instance being built.
+ *
+ * @return A pointer to the #az_json_writer of the template.
+ */
+AZ_NODISCARD AZ_INLINE az_json_writer*
+az_json_template_get_writer(az_json_template* ref_json_template)
+{
+  return &ref_json_template->_internal.writer;
+}
+
+/**
+ * @brief Appends a value slot to the template, where a value is expected by its writer.
+ *
+ * @param[in,out] ref_json_template A pointer to the #az_json_template instance being built.
+ * @param[in] type The type of the values written into the slot.
+ * @param[in] fractional_digits For #AZ_JSON_BIND_DOUBLE, the number of digits to write after the
+ * decimal point, as by #az_json_writer_append_double(), or #AZ_JSON_BIND_DOUBLE_SHORTEST. It is
+ * ignored for the other types.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The template buffer or the slots array is too small.
+ */
+AZ_NODISCARD az_result az_json_template_append_slot(
+    az_json_template* ref_json_template,
+    az_json_bind_type type,
+    int32_t fractional_digits);
+
+/**
+ * @brief Writes JSON from an #az_json_template, filling in its slots in order.
+ */
+typedef struct
+{
+  struct
+  {
+    az_json_template const* json_template;
+    az_span destination_buffer;
+    int32_t bytes_written;
+    int32_t template_offset;
+    int32_t slot_index;
+  } _internal;
+} az_json_template_writer;
+
+/**
+ * @brief Initializes an #az_json_template_writer, which writes JSON from a complete template.
+ *
+ * @param[out] out_template_writer A pointer to the #az_json_template_writer instance to initialize.
+ * @param[in] json_template A pointer to the complete #az_json_template, which must outlive the
+ * #az_json_template_writer.
+ * @param[in] destination_buffer The buffer which receives the JSON text.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The template writer was initialized successfully.
+ */
+AZ_NODISCARD az_result az_json_template_writer_init(
+    az_json_template_writer* out_template_writer,
+    az_json_template const* json_template,
+    az_span destination_buffer);
+
+/**
+ * @brief Fills the next slot of the template, which must be an #AZ_JSON_BIND_BOOLEAN slot.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to write.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The value was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_bool(az_json_template_writer* ref_template_writer, bool value);
+
+/**
+ * @brief Fills the next slot of the template, which must be an #AZ_JSON_BIND_INT32 slot.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to write.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The value was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_int32(az_json_template_writer* ref_template_writer, int32_t value);
+
+/**
+ * @brief Fills the next slot of the template, which must be an #AZ_JSON_BIND_UINT32 slot.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to write.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The value was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_uint32(az_json_template_writer* ref_template_writer, uint32_t value);
+
+/**
+ * @brief Fills the next slot of the template, which must be an #AZ_JSON_BIND_INT64 slot.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to write.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The value was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_int64(az_json_template_writer* ref_template_writer, int64_t value);
+
+/**
+ * @brief Fills the next slot of the template, which must be an #AZ_JSON_BIND_DOUBLE slot.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to write, which must be finite.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The value was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_double(az_json_template_writer* ref_template_writer, double value);
+
+/**
+ * @brief Fills the next slot of the template, which must be an #AZ_JSON_BIND_STRING slot.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The UTF-8 encoded value to write as a JSON string. It is escaped before writing.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The value was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR \p value isn't valid UTF-8, and the template was initialized
+ * with #az_json_writer_options.validate_utf8 set.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_string(az_json_template_writer* ref_template_writer, az_span value);
+
+/**
+ * @brief Writes the rest of the template, after all of its slots have been filled, and returns the
+ * JSON text.
+ *
+ * @param[in,out] ref_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[out] out_json A pointer to an #az_span which receives the JSON text within the destination
+ * buffer.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON text was written successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_get_json(az_json_template_writer* ref_template_writer, az_span* out_json);
+
+/************************************ JSON TRANSFORM ******************/
+
+/**
+ * @brief What #az_json_transform() does with the property or array element that an
+ * #az_json_transform_rule refers to.
+ */
+typedef enum
+{
+  /// The property or array element is left out.
+  AZ_JSON_TRANSFORM_DROP = 1,
+
+  /// The property is written with the name given by #az_json_transform_rule.new_name.
+  AZ_JSON_TRANSFORM_RENAME = 2,
+
+  /// The property or array element is kept, while the other properties of the objects containing
+  /// it, which aren't referred to by any rule, are left out.
+  AZ_JSON_TRANSFORM_KEEP = 3,
+} az_json_transform_action;
+
+/**
+ * @brief Describes how #az_json_transform() rewrites a single property or array element.
+ *
+ * @remarks An array of rules is typically declared once, as a `static const` table.
+ */
+typedef struct
+{
+  /// The JSON pointer path (as defined by RFC 6901) of the property or array element, relative to
+  /// the value being transformed, such as `/properties/temperature` or `/items/0`.
+  az_span path;
+
+  /// What is done with the property or array element.
+  az_json_transform_action action;
+
+  /// For #AZ_JSON_TRANSFORM_RENAME, the unescaped new name of the property.
+  az_span new_name;
+} az_json_transform_rule;
+
+/**
+ * @brief Reads the current JSON value from an #az_json_reader and writes it to an #az_json_writer,
+ * dropping, renaming and keeping properties as described by a set of rules, in a single forward
+ * pass.
+ *
+ * @param[in,out] ref_json_reader A pointer to an #az_json_reader instance over a single,
+ * contiguous buffer, containing the JSON to transform.
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance, to which the transformed
+ * JSON value is appended.
+ * @param[in] rules An array of #az_json_transform_rule.
+ * @param[in] number_of_rules The number of rules within the \p rules array. It must be between 0
+ * and 16.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON value was transformed successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON document is reached.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination of the writer is too small.
+ *
+ * @remarks If the current token kind of the reader is none (i.e. nothing has been read yet), the
+ * reader first moves to the first token. If it is a property name, the reader first moves to the
+ * property value. Afterwards, the reader is at the last token of that value.
+ *
+ * @remarks Only the objects and arrays which contain the property or array element referred to by
+ * a rule are read a token at a time. Every other value, including the value of a renamed or kept
+ * property, is copied to the writer as is, whitespace included, without being read again by the
+ * writer. Set #az_json_reader_options.skip_children_without_validation to find the end of the
+ * objects and arrays copied this way a block at a time.
+ *
+ * @remarks The transformed value is appended to the writer like any other value, so it can be
+ * wrapped within an envelope by appending the start of the envelope beforehand, and its end
+ * afterwards.
+ */
+AZ_NODISCARD az_result az_json_transform(
+    az_json_reader* ref_json_reader,
+    az_json_writer* ref_json_writer,
+    az_json_transform_rule const rules[],
+    int32_t number_of_rules);
+
+/************************************ JSON MERGE PATCH ******************/
+
+/**
+ * @brief Applies a JSON merge patch (as defined by RFC 7396) to a base JSON value, reading both
+ * from #az_json_reader instances and writing the result to an #az_json_writer, in a single
+ * forward pass over the base value.
+ *
+ * @param[in,out] ref_base_reader A pointer to an #az_json_reader instance over a single, contiguous
+ * buffer, containing the base JSON value, such as the last known desired properties of a twin.
+ * @param[in,out] ref_patch_reader A pointer to an #az_json_reader instance over a single,
+ * contiguous buffer, containing the merge patch, such as a desired properties update.
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance, to which the patched
+ * JSON value is appended.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The patch was applied successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of a JSON document is reached.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination of the writer is too small.
+ *
+ * @remarks If the current token kind of a reader is none (i.e. nothing has been read yet), it first
+ * moves to the first token. If it is a property name, it first moves to the property value.
+ * Afterwards, both readers are at the last token of their value.
+ *
+ * @remarks The properties of the base object keep their order, and those added by the patch follow
+ * them. Values which aren't merged are copied as is. Each property of an object is looked up in the
+ * other object by reading it again, so no memory is needed beyond a few #az_json_reader copies for
+ * each level of nesting, at the cost of time proportional to the product of the number of
+ * properties of the objects merged.
+ */
+AZ_NODISCARD az_result az_json_merge_patch_apply(
+    az_json_reader* ref_base_reader,
+    az_json_reader* ref_patch_reader,
+    az_json_writer* ref_json_writer);
+
+/**
+ * @brief Writes the JSON merge patch (as defined by RFC 7396) which turns a source JSON value into
+ * a target JSON value, containing only the properties which were added, removed or changed.
+ *
+ * @param[in,out] ref_source_reader A pointer to an #az_json_reader instance over a single,
+ * contiguous buffer, containing the source JSON value, such as the reported properties last sent.
+ * @param[in,out] ref_target_reader A pointer to an #az_json_reader instance over a single,
+ * contiguous buffer, containing the target JSON value, such as the current reported properties.
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance, initialized by
+ * #az_json_writer_init() or #az_json_writer_sizing_init(), to which the merge patch is appended. A
+ * writer initialized by #az_json_writer_chunked_init() is not supported.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The merge patch was written successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of a JSON document is reached.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination of the writer is too small.
+ *
+ * @remarks If the current token kind of a reader is none (i.e. nothing has been read yet), it first
+ * moves to the first token. If it is a property name, it first moves to the property value.
+ * Afterwards, both readers are at the last token of their value.
+ *
+ * @remarks Removed properties are set to null, and objects are patched property by property,
+ * leaving out those within which nothing changed. Other values are compared token by token, as
+ * they are written, and are copied as is from the target when they differ. Unless both values are
+ * objects, the patch is the target value itself. Since a merge patch can't set a property to null,
+ * properties whose value is null within the target are removed when the patch is applied.
+ */
+AZ_NODISCARD az_result az_json_merge_patch_create(
+    az_json_reader* ref_source_reader,
+    az_json_reader* ref_target_reader,
+    az_json_writer* ref_json_writer);
+
+/************************************ JSON ARRAY SPLIT ******************/
+
+/**
+ * @brief A run of consecutive elements of a top-level JSON array, found by #az_json_array_split(),
+ * which can be read independently of the other elements of the array.
+ */
+typedef struct
+{
+  /// The text of the elements, separated by commas, without the surrounding whitespace.
+  az_span elements;
+
+  /// The index, within the whole array, of the first element within #elements.
+  int32_t first_element_index;
+
+  /// The number of elements within #elements.
+  int32_t number_of_elements;
+
+  /// The result of reading the elements within #elements by #az_json_array_parse_parts().
+  az_result result;
+} az_json_array_part;
+
+/**
+ * @brief Defines the signature of the callback function that #az_json_array_parse_parts() calls
+ * for each element of a top-level JSON array.
+ *
+ * @param[in,out] ref_json_reader A pointer to an #az_json_reader instance over the element, on
+ * which no token has been read yet.
+ * @param[in] element_index The index of the element within the whole array.
+ * @param[in] user_context The user-defined context passed to #az_json_array_parse_parts().
+ *
+ * @return An #az_result value indicating the result of the operation. Any failed result stops the
+ * reading of the elements of the same #az_json_array_part.
+ *
+ * @remarks The callback can be called concurrently for elements of different parts. Results stored
+ * by element index, such as within an array indexed by \p element_index, are the same whatever
+ * order the parts are read in.
+ */
+typedef az_result (*az_json_array_element_fn)(
+    az_json_reader* ref_json_reader,
+    int32_t element_index,
+    void* user_context);
+
+/**
+ * @brief Defines the signature of a task run by an #az_json_array_run_tasks_fn callback.
+ *
+ * @param[in] task_context The context passed to the #az_json_array_run_tasks_fn callback.
+ * @param[in] task_index The index of the task to run, from 0 to the number of tasks, exclusive.
+ */
+typedef void (*az_json_array_task_fn)(void* task_context, int32_t task_index);
+
+/**
+ * @brief Defines the signature of the callback function through which #az_json_array_parse_parts()
+ * runs its tasks on a worker pool owned by the caller.
+ *
+ * @param[in] pool_context The user-defined context passed to #az_json_array_parse_parts(), such as
+ * the worker pool.
+ * @param[in] task The task to run.
+ * @param[in] task_context The context to pass to each call of \p task.
+ * @param[in] number_of_tasks The number of tasks to run, each with a different task index.
+ *
+ * @remarks The callback must call \p task once for each task index, on any worker and in any
+ * order, and only return once all the tasks have completed, such that their results are visible
+ * to the calling thread.
+ */
+typedef void (*az_json_array_run_tasks_fn)(
+    void* pool_context,
+    az_json_array_task_fn task,
+    void* task_context,
+    int32_t number_of_tasks);
+
+/**
+ * @brief Splits a top-level JSON array into parts of consecutive elements of about the same size,
+ * which can be read in parallel.
+ *
+ * @param[in] json_array The JSON text of the array.
+ * @param[out] out_parts A pointer to an array of #az_json_array_part which receives the parts, in
+ * the order of their elements.
+ * @param[in] parts_size The number of items within the \p out_parts array. It must be greater than
+ * 0.
+ * @param[out] out_number_of_parts A pointer to an `int32_t` which receives the number of parts,
+ * which is 0 for an empty array, and which is never greater than \p parts_size.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The array was split successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON text is reached before the end of the array.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The JSON text isn't an array, or an array is ended by a `}`, or
+ * the array is followed by something other than whitespace.
+ *
+ * @remarks The array is split at the commas between its elements, which are found with a scan of
+ * the structure of the JSON text a block at a time, keeping track of strings and nesting only. The
+ * elements themselves are only validated when they are read.
+ */
+AZ_NODISCARD az_result az_json_array_split(
+    az_span json_array,
+    az_json_array_part out_parts[],
+    int32_t parts_size,
+    int32_t* out_number_of_parts);
+
+/**
+ * @brief Initializes an #az_json_reader instance over the first element of an
+ * #az_json_array_part, and removes that element from the part.
+ *
+ * @param[in,out] ref_part A pointer to an #az_json_array_part instance, whose
+ * #az_json_array_part.first_element_index is the index of the element read on success.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the #az_json_reader. If `NULL` is passed, the reader will use the
+ * default options (i.e. #az_json_reader_options_default()).
+ * @param[out] out_json_reader A pointer to an #az_json_reader instance to initialize.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The reader was initialized over the next element.
+ * @retval #AZ_ERROR_JSON_READER_DONE There are no more elements within the part.
+ * @retval #AZ_ERROR_UNEXPECTED_END An element is empty.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An element ends with an unmatched `]` or `}`.
+ */
+AZ_NODISCARD az_result az_json_array_part_next_element(
+    az_json_array_part* ref_part,
+    az_json_reader_options const* options,
+    az_json_reader* out_json_reader);
+
+/**
+ * @brief Reads the elements of each #az_json_array_part found by #az_json_array_split(), one task
+ * for each part, calling a callback with a reader over each element.
+ *
+ * @param[in,out] ref_parts A pointer to the array of parts, whose #az_json_array_part.result
+ * receives the result of reading its elements.
+ * @param[in] number_of_parts The number of parts within the \p ref_parts array.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the readers over the elements. If `NULL` is passed, the readers will
+ * use the default options (i.e. #az_json_reader_options_default()).
+ * @param[in] element_callback The #az_json_array_element_fn called for each element.
+ * @param[in] user_context A user-defined context passed to \p element_callback.
+ * @param[in] run_tasks __[nullable]__ The #az_json_array_run_tasks_fn which runs the task of each
+ * part on a worker pool. If `NULL` is passed, the parts are read one after the other on the calling
+ * thread.
+ * @param[in] pool_context A user-defined context passed to \p run_tasks.
+ *
+ * @return The result of the first part, in the order of the elements, whose elements couldn't all
+ * be read, or #AZ_OK if all the elements were read successfully.
+ *
+ * @remarks Each task uses its own #az_json_reader, on its own stack, and only writes to its own
+ * part, so the tasks share nothing but \p user_context. Since the first failed part is chosen in
+ * the order of the elements, the result doesn't depend on the order in which the tasks complete.
+ */
+AZ_NODISCARD az_result az_json_array_parse_parts(
+    az_json_array_part ref_parts[],
+    int32_t number_of_parts,
+    az_json_reader_options const* options,
+    az_json_array_element_fn element_callback,
+    void* user_context,
+    az_json_array_run_tasks_fn run_tasks,
+    void* pool_context);
+
+/************************************ JSON LINES READER ******************/
+
+/**
+ * @brief Returns the records of JSON Lines (also known as newline-delimited JSON, or NDJSON) text,
+ * each of them being a JSON value on its own line, such as telemetry buffered to a file while
+ * offline.
+ *
+ * @remarks The text is typically a file mapped into memory by the platform, in which case the
+ * records are read straight from the mapping without being copied.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The whole JSON Lines text.
+    az_span json_lines;
+
+    /// The offset within the text of the line after the current record.
+    int32_t offset;
+
+    /// Whether the text ends the JSON Lines, so that its last line is a record even without a line
+    /// ending.
+    bool is_final;
+
+    /// A copy of the options provided by the user.
+    az_json_reader_options options;
+  } _internal;
+} az_json_lines_reader;
+
+/**
+ * @brief Initializes an #az_json_lines_reader to read the records of JSON Lines text, starting at
+ * a given offset.
+ *
+ * @param[out] out_json_lines_reader A pointer to an #az_json_lines_reader instance to initialize.
+ * @param[in] json_lines An #az_span over the whole JSON Lines text.
+ * @param[in] offset The offset within \p json_lines of the first line to read, such as 0, or an
+ * offset previously returned by #az_json_lines_reader_get_offset() to resume reading after the last
+ * record processed. It must be between 0 and the size of \p json_lines.
+ * @param[in] is_final `true` if \p json_lines extends to the end of the JSON Lines, so that its
+ * last line is a record even without a line ending, or `false` if more text may follow it.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the #az_json_reader instances over each record. If `NULL` is passed,
+ * the readers will use the default options (i.e. #az_json_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_lines_reader is initialized successfully.
+ *
+ * @remarks Since an #az_span is at most 2 GiB, a larger file is read one window of its mapping at a
+ * time, passing `false` for \p is_final except for the last window. Each window is resumed at the
+ * offset, relative to it, returned once the previous one has no more records, which is the start of
+ * any record cut off by the end of that window.
+ */
+AZ_NODISCARD az_result az_json_lines_reader_init(
+    az_json_lines_reader* out_json_lines_reader,
+    az_span json_lines,
+    int32_t offset,
+    bool is_final,
+    az_json_reader_options const* options);
+
+/**
+ * @brief Initializes an #az_json_reader over the next record of the JSON Lines text.
+ *
+ * @param[in,out] ref_json_lines_reader A pointer to an #az_json_lines_reader instance.
+ * @param[out] out_json_reader A pointer to an #az_json_reader instance to initialize over the
+ * record, on which no token has been read yet.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The reader was initialized over the next record.
+ * @retval #AZ_ERROR_JSON_READER_DONE There are no more records within the text.
+ * @retval #AZ_ERROR_UNEXPECTED_END The text wasn't initialized as final, and its last line has a
+ * record but no line ending. The offset is left at the start of that line, so that reading can be
+ * resumed from it once more of the text is available.
+ *
+ * @remarks The end of each line is found 16 bytes at a time, where SIMD instructions are available.
+ * Lines are ended by `\n`, optionally preceded by `\r`, and the last line of final text may have no
+ * line ending.
+ * Lines which only contain whitespace are skipped. Each record is only validated when it is read.
+ */
+AZ_NODISCARD az_result az_json_lines_reader_next_record(
+    az_json_lines_reader* ref_json_lines_reader,
+    az_json_reader* out_json_reader);
+
+/**
+ * @brief Returns the offset within the JSON Lines text of the line following the last record
+ * returned by #az_json_lines_reader_next_record(), from which reading can later be resumed.
+ *
+ * @param[in] json_lines_reader A pointer to an #az_json_lines_reader instance.
+ *
+ * @return The offset of the line following the last record returned, or the offset given to
+ * #az_json_lines_reader_init() if no record was returned yet. Once the text of a reader which isn't
+ * final has no more records, it is the offset of its last line, which has no line ending.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+az_json_lines_reader_get_offset(az_json_lines_reader const* json_lines_reader)
+{
+  return json_lines_reader->_internal.offset;
+}
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_JSON_H
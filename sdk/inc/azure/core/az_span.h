@@ -374,6 +374,9 @@ AZ_NODISCARD az_result az_span_atoi32(az_span source, int32_t* out_number);
  *
  * @remark The #az_span being parsed must contain a number that is finite. Values such as `NaN`,
  * `INFINITY`, and those that would overflow a `double` to `+/-inf` are not allowed.
+ *
+ * @remark The number is rounded to the nearest `double` (ties to even), and parsing doesn't depend
+ * on the current locale.
  */
 AZ_NODISCARD az_result az_span_atod(az_span source, double* out_number);
 
@@ -476,6 +479,37 @@ AZ_NODISCARD az_result az_span_u64toa(az_span destination, uint64_t source, az_s
 AZ_NODISCARD az_result
 az_span_dtoa(az_span destination, double source, int32_t fractional_digits, az_span* out_span);
 
+/**
+ * @brief Converts a `double` into the shortest sequence of digit characters (base 10) which parses
+ * back to the same `double`, and copies them to the \p destination #az_span starting at its 0-th
+ * index.
+ *
+ * @param destination The #az_span where the bytes should be copied to.
+ * @param[in] source The `double` whose number is copied to the \p destination #az_span as ASCII
+ * digits and characters.
+ * @param[out] out_span A pointer to an #az_span that receives the remainder of the \p destination
+ * #az_span after the `double` has been copied.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination is not big enough to contain the copied
+ * bytes.
+ * @retval #AZ_ERROR_NOT_SUPPORTED The \p source is not a finite decimal number.
+ *
+ * @remark Only finite `double` values are supported. Values such as `NaN` and `INFINITY` are not
+ * allowed. Unlike #az_span_dtoa(), the whole range of finite `double` values is supported.
+ *
+ * @remark When several numbers with the fewest digits parse back to the same `double`, the one
+ * closest to the exact value of \p source is written. Parsing the result with #az_span_atod()
+ * always gives back \p source.
+ *
+ * @remark The number is written in decimal notation (such as `0.001` or `123.45`), unless the
+ * decimal point would be more than 21 digits after, or 6 zeros before, the first significant
+ * digit, in which case exponent notation (such as `1e+21` or `1.5e-7`) is used, the same way as
+ * JavaScript. At most 25 bytes are written.
+ */
+AZ_NODISCARD az_result az_span_dtoa_shortest(az_span destination, double source, az_span* out_span);
+
 /******************************  NON-CONTIGUOUS SPAN  */
 
 /**
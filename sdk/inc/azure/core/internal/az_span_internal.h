@@ -43,6 +43,27 @@ AZ_INLINE AZ_NODISCARD int32_t _az_span_diff(az_span sliced_span, az_span origin
   return answer;
 }
 
+/**
+ * @brief Gives the number of digits (base 10) needed to write \p number, without dividing it.
+ *
+ * @param[in] number The number whose length, as a string, is to be evaluated.
+ * @return The length (not considering null terminator) of the string that would represent the given
+ * number.
+ */
+AZ_NODISCARD int32_t _az_span_u64toa_size(uint64_t number);
+
+/**
+ * @brief Gives the number of digits (base 10) needed to write \p number, without dividing it.
+ *
+ * @param[in] number The number whose length, as a string, is to be evaluated.
+ * @return The length (not considering null terminator) of the string that would represent the given
+ * number.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_span_u32toa_size(uint32_t number)
+{
+  return _az_span_u64toa_size(number);
+}
+
 /**
  * @brief Copies character from the \p source #az_span to the \p destination #az_span by
  * URL-encoding the \p source span characters.
@@ -66,7 +66,8 @@ static az_span const command_empty_response_payload = AZ_SPAN_LITERAL_FROM_STR("
 static char command_property_scratch_buffer[64];
 
 // IoT Hub Telemetry Values
-static az_span const telemetry_working_set_name = AZ_SPAN_LITERAL_FROM_STR("workingSet");
+static az_json_prepared_property_name const telemetry_working_set_name
+    = AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR("workingSet");
 
 static iot_sample_environment_variables env_vars;
 static az_iot_hub_client hub_client;
@@ -136,7 +137,8 @@ static void temp_controller_invoke_reboot(void);
 static void property_callback(
     az_span component_name,
     az_json_token const* property_name,
-    az_json_reader property_value,
+    az_span twin_message_span,
+    az_json_cursor const* property_value_cursor,
     int32_t version,
     void* user_context_callback);
 static az_result append_int32_callback(az_json_writer* jw, void* value);
@@ -936,7 +938,7 @@ static void temp_controller_build_telemetry_message(az_span payload, az_span* ou
 
   pnp_build_telemetry_message(
       payload,
-      telemetry_working_set_name,
+      &telemetry_working_set_name,
       append_int32_callback,
       (void*)&working_set_ram_in_kibibytes,
       out_payload);
@@ -1060,7 +1062,8 @@ static void temp_controller_invoke_reboot(void)
 static void property_callback(
     az_span component_name,
     az_json_token const* property_name,
-    az_json_reader property_value,
+    az_span twin_message_span,
+    az_json_cursor const* property_value_cursor,
     int32_t version,
     void* user_context_callback)
 {
@@ -1068,6 +1071,16 @@ static void property_callback(
 
   (void)user_context_callback;
 
+  // Resume reading the twin message at the property value.
+  az_json_reader property_value;
+  rc = az_json_reader_init_at_cursor(
+      &property_value, twin_message_span, property_value_cursor, NULL);
+  if (az_result_failed(rc))
+  {
+    IOT_SAMPLE_LOG_ERROR("Failed to read the property value: az_result return code 0x%08x.", rc);
+    exit(rc);
+  }
+
   // Get the Twin Patch topic to send a property update.
   rc = az_iot_hub_client_twin_patch_get_publish_topic(
       &hub_client,
@@ -26,9 +26,11 @@ static az_span const component_specifier_value = AZ_SPAN_LITERAL_FROM_STR("c");
 static az_span const command_separator = AZ_SPAN_LITERAL_FROM_STR("/");
 static az_span const iot_hub_twin_desired_version = AZ_SPAN_LITERAL_FROM_STR("$version");
 static az_span const iot_hub_twin_desired = AZ_SPAN_LITERAL_FROM_STR("desired");
+static az_span const iot_hub_twin_desired_version_path = AZ_SPAN_LITERAL_FROM_STR("/$version");
 
 // Visit each valid property for the component
 static void visit_component_properties(
+    az_span twin_message_span,
     az_span component_name,
     az_json_reader* jr,
     int32_t version,
@@ -52,7 +54,14 @@ static void visit_component_properties(
       az_json_token property_name = jr->token;
       IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_reader_next_token(jr), log);
 
-      property_callback(component_name, &property_name, *jr, version, context_ptr);
+      az_json_cursor const property_value_cursor = az_json_reader_get_cursor(jr);
+      property_callback(
+          component_name,
+          &property_name,
+          twin_message_span,
+          &property_value_cursor,
+          version,
+          context_ptr);
     }
     else if (jr->token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
     {
@@ -280,7 +289,7 @@ void pnp_build_reported_property_with_status(
 
 void pnp_build_telemetry_message(
     az_span json_buffer,
-    az_span property_name,
+    az_json_prepared_property_name const* property_name,
     pnp_append_property_callback append_callback,
     void* property_value,
     az_span* out_span)
@@ -290,7 +299,8 @@ void pnp_build_telemetry_message(
   az_json_writer jw;
   IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_init(&jw, json_buffer, NULL), log);
   IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_begin_object(&jw), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_property_name(&jw, property_name), log);
+  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
+      az_json_writer_append_prepared_property_name(&jw, property_name), log);
   IOT_SAMPLE_EXIT_IF_AZ_FAILED(append_callback(&jw, property_value), log);
   IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_end_object(&jw), log);
 
@@ -324,10 +334,13 @@ void pnp_process_device_twin_message(
     return;
   }
 
-  // Parse for `$version` if it exists.
-  az_json_reader copy_jr = jr;
-  if (!json_child_token_move(&copy_jr, iot_hub_twin_desired_version)
-      || az_result_failed(az_json_token_get_int32(&(copy_jr.token), (int32_t*)&version)))
+  // Parse for `$version` if it exists, skipping over the nested component objects, then resume
+  // reading at the start of the properties.
+  az_json_cursor const properties_cursor = az_json_reader_get_cursor(&jr);
+  az_json_token version_token;
+  if (az_result_failed(az_json_reader_find_paths(
+          &jr, &iot_hub_twin_desired_version_path, 1, &version_token))
+      || az_result_failed(az_json_token_get_int32(&version_token, (int32_t*)&version)))
   {
     IOT_SAMPLE_LOG(
         "`%.*s` was not found in device twin message.",
@@ -336,6 +349,9 @@ void pnp_process_device_twin_message(
     return;
   }
 
+  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
+      az_json_reader_init_at_cursor(&jr, twin_message_span, &properties_cursor, NULL), log);
+
   // Parse the properties and call property_callback for each.
   az_json_token property_name;
   while (az_result_succeeded(az_json_reader_next_token(&jr)))
@@ -358,11 +374,23 @@ void pnp_process_device_twin_message(
           && is_component_in_model(property_name.slice, components_ptr, components_num, &index))
       {
         visit_component_properties(
-            *components_ptr[index], &jr, version, property_callback, context_ptr);
+            twin_message_span,
+            *components_ptr[index],
+            &jr,
+            version,
+            property_callback,
+            context_ptr);
       }
       else
       {
-        property_callback(AZ_SPAN_EMPTY, &property_name, jr, version, context_ptr);
+        az_json_cursor const property_value_cursor = az_json_reader_get_cursor(&jr);
+        property_callback(
+            AZ_SPAN_EMPTY,
+            &property_name,
+            twin_message_span,
+            &property_value_cursor,
+            version,
+            context_ptr);
       }
     }
     else if (jr.token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
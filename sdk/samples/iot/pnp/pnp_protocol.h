@@ -14,11 +14,14 @@
 /**
  * @brief Callback which is invoked for each property found by the
  * #pnp_process_device_twin_message() API.
+ * @remark The property value is the current token of an #az_json_reader initialized with
+ * #az_json_reader_init_at_cursor() over \p twin_message_span at \p property_value_cursor.
  */
 typedef void (*pnp_property_callback)(
     az_span component_name,
     az_json_token const* property_name,
-    az_json_reader property_value_as_json,
+    az_span twin_message_span,
+    az_json_cursor const* property_value_cursor,
     int32_t version,
     void* user_context_callback);
 
@@ -109,14 +112,15 @@ void pnp_build_reported_property_with_status(
  * @brief Build a simple telemetry message using one property name and one value.
  *
  * @param[in] json_buffer An #az_span with sufficient capacity to hold the json payload.
- * @param[in] property_name The name of the property for which to send telemetry.
+ * @param[in] property_name The prepared name of the property for which to send telemetry, which is
+ * copied into the payload as is.
  * @param[in] append_callback The user callback to invoke to add the property value.
  * @param[in] property_value The property value which is passed to the callback to be appended.
  * @param[out] out_span A pointer to the #az_span containing the output json payload.
  */
 void pnp_build_telemetry_message(
     az_span json_buffer,
-    az_span property_name,
+    az_json_prepared_property_name const* property_name,
     pnp_append_property_callback append_callback,
     void* property_value,
     az_span* out_span);
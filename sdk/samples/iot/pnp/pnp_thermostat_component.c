@@ -36,17 +36,47 @@ static az_span const twin_response_failed = AZ_SPAN_LITERAL_FROM_STR("failed");
 
 // IoT Hub Commands Values
 static az_span const command_getMaxMinReport_name = AZ_SPAN_LITERAL_FROM_STR("getMaxMinReport");
-static az_span const command_max_temp_name = AZ_SPAN_LITERAL_FROM_STR("maxTemp");
-static az_span const command_min_temp_name = AZ_SPAN_LITERAL_FROM_STR("minTemp");
-static az_span const command_avg_temp_name = AZ_SPAN_LITERAL_FROM_STR("avgTemp");
-static az_span const command_start_time_name = AZ_SPAN_LITERAL_FROM_STR("startTime");
-static az_span const command_end_time_name = AZ_SPAN_LITERAL_FROM_STR("endTime");
 static az_span const command_empty_response_payload = AZ_SPAN_LITERAL_FROM_STR("{}");
 static char command_start_time_value_buffer[32];
 static char command_end_time_value_buffer[32];
 
 // IoT Hub Telemetry Values
-static az_span const telemetry_temperature_name = AZ_SPAN_LITERAL_FROM_STR("temperature");
+static az_json_prepared_property_name const telemetry_temperature_name
+    = AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR("temperature");
+
+// The response to the getMaxMinReport command.
+typedef struct
+{
+  double maximum_temperature;
+  double minimum_temperature;
+  double average_temperature;
+  az_json_bind_string start_time;
+  az_json_bind_string end_time;
+} max_min_report;
+
+static az_json_bind_field const max_min_report_fields[] = {
+  { .name = AZ_SPAN_LITERAL_FROM_STR("maxTemp"),
+    .type = AZ_JSON_BIND_DOUBLE,
+    .offset = offsetof(max_min_report, maximum_temperature),
+    .fractional_digits = DOUBLE_DECIMAL_PLACE_DIGITS },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("minTemp"),
+    .type = AZ_JSON_BIND_DOUBLE,
+    .offset = offsetof(max_min_report, minimum_temperature),
+    .fractional_digits = DOUBLE_DECIMAL_PLACE_DIGITS },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("avgTemp"),
+    .type = AZ_JSON_BIND_DOUBLE,
+    .offset = offsetof(max_min_report, average_temperature),
+    .fractional_digits = DOUBLE_DECIMAL_PLACE_DIGITS },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("startTime"),
+    .type = AZ_JSON_BIND_STRING,
+    .offset = offsetof(max_min_report, start_time) },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("endTime"),
+    .type = AZ_JSON_BIND_STRING,
+    .offset = offsetof(max_min_report, end_time) },
+};
+
+// Initialized from max_min_report_fields by pnp_thermostat_init.
+static az_json_bind_table max_min_report_table;
 
 static void build_command_response_payload(
     pnp_thermostat_component const* thermostat_component,
@@ -57,34 +87,17 @@ static void build_command_response_payload(
 {
   char const* const log = "Failed to build command response payload";
 
+  max_min_report const report = {
+    .maximum_temperature = thermostat_component->maximum_temperature,
+    .minimum_temperature = thermostat_component->minimum_temperature,
+    .average_temperature = thermostat_component->average_temperature,
+    .start_time = { .buffer = start_time, .length = az_span_size(start_time) },
+    .end_time = { .buffer = end_time, .length = az_span_size(end_time) },
+  };
+
   az_json_writer jw;
   IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_init(&jw, payload, NULL), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_begin_object(&jw), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_property_name(&jw, command_max_temp_name), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_double(
-          &jw, thermostat_component->maximum_temperature, DOUBLE_DECIMAL_PLACE_DIGITS),
-      log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_property_name(&jw, command_min_temp_name), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_double(
-          &jw, thermostat_component->minimum_temperature, DOUBLE_DECIMAL_PLACE_DIGITS),
-      log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_property_name(&jw, command_avg_temp_name), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_double(
-          &jw, thermostat_component->average_temperature, DOUBLE_DECIMAL_PLACE_DIGITS),
-      log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_property_name(&jw, command_start_time_name), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_string(&jw, start_time), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(
-      az_json_writer_append_property_name(&jw, command_end_time_name), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_string(&jw, end_time), log);
-  IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_writer_append_end_object(&jw), log);
+  IOT_SAMPLE_EXIT_IF_AZ_FAILED(az_json_bind_write(&jw, &max_min_report_table, &report), log);
 
   *out_payload = az_json_writer_get_bytes_used_in_destination(&jw);
 }
@@ -168,7 +181,10 @@ az_result pnp_thermostat_init(
   out_thermostat_component->temperature_summation = initial_temperature;
   out_thermostat_component->send_maximum_temperature_property = true;
 
-  return AZ_OK;
+  return az_json_bind_table_init(
+      &max_min_report_table,
+      max_min_report_fields,
+      sizeof(max_min_report_fields) / sizeof(max_min_report_fields[0]));
 }
 
 void pnp_thermostat_build_telemetry_message(
@@ -178,7 +194,7 @@ void pnp_thermostat_build_telemetry_message(
 {
   pnp_build_telemetry_message(
       payload,
-      telemetry_temperature_name,
+      &telemetry_temperature_name,
       append_double_callback,
       (void*)&thermostat_component->current_temperature,
       out_payload);
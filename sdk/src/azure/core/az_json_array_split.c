@@ -0,0 +1,319 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include "az_simd_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+#include <azure/core/internal/az_span_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+// Finds the commas between the elements of an array, and the end of the array, a block at a time,
+// in the same way as az_json_reader_skip_children() finds the end of an object or array.
+typedef struct
+{
+  az_span text;
+  int32_t block_offset;
+  uint64_t pending;
+  uint64_t opens;
+  uint64_t commas;
+  uint64_t prev_in_string;
+  uint64_t prev_escaped;
+  int32_t depth;
+} _az_json_array_scanner;
+
+AZ_NODISCARD static _az_json_array_scanner _az_json_array_scanner_create(az_span text)
+{
+  return (_az_json_array_scanner){
+    .text = text,
+    .block_offset = -_az_SIMD_JSON_BLOCK_SIZE,
+    .pending = 0,
+    .opens = 0,
+    .commas = 0,
+    .prev_in_string = 0,
+    .prev_escaped = 0,
+    .depth = 0,
+  };
+}
+
+// Returns the offset of the next comma outside of any nested object or array, or of the unmatched
+// closing bracket which ends the text, or AZ_ERROR_UNEXPECTED_END if there is none.
+AZ_NODISCARD static az_result _az_json_array_scanner_next(
+    _az_json_array_scanner* ref_scanner,
+    int32_t* out_offset)
+{
+  int32_t const text_size = az_span_size(ref_scanner->text);
+  uint8_t last_block[_az_SIMD_JSON_BLOCK_SIZE];
+
+  while (true)
+  {
+    for (; ref_scanner->pending != 0; ref_scanner->pending &= ref_scanner->pending - 1)
+    {
+      int32_t const position = _az_simd_count_trailing_zeros(ref_scanner->pending);
+      uint64_t const bit = 1ULL << (uint32_t)position;
+
+      if ((ref_scanner->commas & bit) != 0)
+      {
+        if (ref_scanner->depth != 0)
+        {
+          continue;
+        }
+      }
+      else if ((ref_scanner->opens & bit) != 0)
+      {
+        ref_scanner->depth++;
+        continue;
+      }
+      else if (--ref_scanner->depth >= 0)
+      {
+        continue;
+      }
+
+      ref_scanner->pending &= ref_scanner->pending - 1;
+      *out_offset = ref_scanner->block_offset + position;
+      return AZ_OK;
+    }
+
+    int32_t const offset = ref_scanner->block_offset + _az_SIMD_JSON_BLOCK_SIZE;
+    if (offset >= text_size)
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    uint8_t const* block = az_span_ptr(ref_scanner->text) + offset;
+
+    // Pad the trailing partial block with whitespace, which never affects the nesting.
+    if (text_size - offset < _az_SIMD_JSON_BLOCK_SIZE)
+    {
+      az_span const destination = AZ_SPAN_FROM_BUFFER(last_block);
+      az_span_fill(destination, _az_ASCII_SPACE_CHARACTER);
+      az_span_copy(destination, az_span_slice_to_end(ref_scanner->text, offset));
+      block = last_block;
+    }
+
+    _az_simd_json_nesting_masks masks;
+    _az_simd_json_classify_nesting_block(block, &masks);
+
+    uint64_t const escaped
+        = _az_simd_json_find_escaped(masks.backslash, &ref_scanner->prev_escaped);
+    uint64_t const quotes = masks.quote & ~escaped;
+    uint64_t const in_string = _az_simd_prefix_xor(quotes) ^ ref_scanner->prev_in_string;
+    ref_scanner->prev_in_string = 0ULL - (in_string >> 63U);
+
+    uint64_t const opens = masks.open & ~in_string;
+    uint64_t const closes = masks.close & ~in_string;
+    ref_scanner->block_offset = offset;
+
+    // Within a block which doesn't have enough closing brackets to get back to the top level, the
+    // commas all separate values nested deeper, and only the depth needs to be updated.
+    int32_t const close_count = _az_simd_count_set_bits(closes);
+    if (close_count < ref_scanner->depth)
+    {
+      ref_scanner->depth += _az_simd_count_set_bits(opens) - close_count;
+      continue;
+    }
+
+    ref_scanner->opens = opens;
+    ref_scanner->commas = masks.comma & ~in_string;
+    ref_scanner->pending = opens | closes | ref_scanner->commas;
+  }
+}
+
+AZ_NODISCARD az_result az_json_array_split(
+    az_span json_array,
+    az_json_array_part out_parts[],
+    int32_t parts_size,
+    int32_t* out_number_of_parts)
+{
+  _az_PRECONDITION_VALID_SPAN(json_array, 1, false);
+  _az_PRECONDITION_NOT_NULL(out_parts);
+  _az_PRECONDITION(parts_size > 0);
+  _az_PRECONDITION_NOT_NULL(out_number_of_parts);
+
+  az_span const text = _az_span_trim_whitespace_from_start(json_array);
+  if (az_span_size(text) == 0)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+  if (az_span_ptr(text)[0] != '[')
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  az_span const elements = az_span_slice_to_end(text, 1);
+  uint8_t const* const elements_ptr = az_span_ptr(elements);
+
+  // Each part ends at the first comma past its share of the text, so that the parts are about the
+  // same size, however many elements each of them has.
+  int32_t const part_size = az_span_size(elements) / parts_size;
+
+  _az_json_array_scanner scanner = _az_json_array_scanner_create(elements);
+  int32_t number_of_parts = 0;
+  int32_t part_start = 0;
+  int32_t first_element_index = 0;
+  int32_t element_index = 0;
+
+  while (true)
+  {
+    int32_t end = 0;
+    _az_RETURN_IF_FAILED(_az_json_array_scanner_next(&scanner, &end));
+    element_index++;
+
+    bool const is_array_end = elements_ptr[end] != ',';
+    if (is_array_end && elements_ptr[end] != ']')
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
+    if (is_array_end
+        || (number_of_parts < parts_size - 1 && end >= part_size * (number_of_parts + 1)))
+    {
+      az_span const part_elements
+          = _az_span_trim_whitespace(az_span_slice(elements, part_start, end));
+
+      // An array without any element has a single, empty, "element".
+      if (!is_array_end || element_index > 1 || az_span_size(part_elements) > 0)
+      {
+        out_parts[number_of_parts] = (az_json_array_part){
+          .elements = part_elements,
+          .first_element_index = first_element_index,
+          .number_of_elements = element_index - first_element_index,
+          .result = AZ_OK,
+        };
+        number_of_parts++;
+      }
+
+      part_start = end + 1;
+      first_element_index = element_index;
+    }
+
+    if (is_array_end)
+    {
+      if (az_span_size(_az_span_trim_whitespace(az_span_slice_to_end(elements, end + 1))) > 0)
+      {
+        return AZ_ERROR_UNEXPECTED_CHAR;
+      }
+
+      *out_number_of_parts = number_of_parts;
+      return AZ_OK;
+    }
+  }
+}
+
+AZ_NODISCARD az_result az_json_array_part_next_element(
+    az_json_array_part* ref_part,
+    az_json_reader_options const* options,
+    az_json_reader* out_json_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_part);
+  _az_PRECONDITION_NOT_NULL(out_json_reader);
+
+  if (ref_part->number_of_elements <= 0)
+  {
+    return AZ_ERROR_JSON_READER_DONE;
+  }
+
+  // The last element of a part extends to its end.
+  _az_json_array_scanner scanner = _az_json_array_scanner_create(ref_part->elements);
+  int32_t end = az_span_size(ref_part->elements);
+  az_result const result = _az_json_array_scanner_next(&scanner, &end);
+  if (az_result_failed(result) && result != AZ_ERROR_UNEXPECTED_END)
+  {
+    return result;
+  }
+  if (result == AZ_OK && az_span_ptr(ref_part->elements)[end] != ',')
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  az_span const element = _az_span_trim_whitespace(az_span_slice(ref_part->elements, 0, end));
+  if (az_span_size(element) == 0)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  _az_RETURN_IF_FAILED(az_json_reader_init(out_json_reader, element, options));
+
+  ref_part->elements = end < az_span_size(ref_part->elements)
+      ? az_span_slice_to_end(ref_part->elements, end + 1)
+      : AZ_SPAN_EMPTY;
+  ref_part->first_element_index++;
+  ref_part->number_of_elements--;
+  return AZ_OK;
+}
+
+typedef struct
+{
+  az_json_array_part* parts;
+  az_json_reader_options const* options;
+  az_json_array_element_fn element_callback;
+  void* user_context;
+} _az_json_array_parse_context;
+
+static void _az_json_array_parse_part(void* task_context, int32_t task_index)
+{
+  _az_json_array_parse_context const* const context = (_az_json_array_parse_context*)task_context;
+  az_json_array_part* const part = &context->parts[task_index];
+
+  part->result = AZ_OK;
+  while (part->number_of_elements > 0)
+  {
+    int32_t const element_index = part->first_element_index;
+    az_json_reader json_reader;
+
+    part->result = az_json_array_part_next_element(part, context->options, &json_reader);
+    if (az_result_succeeded(part->result))
+    {
+      part->result = context->element_callback(&json_reader, element_index, context->user_context);
+    }
+
+    if (az_result_failed(part->result))
+    {
+      return;
+    }
+  }
+}
+
+AZ_NODISCARD az_result az_json_array_parse_parts(
+    az_json_array_part ref_parts[],
+    int32_t number_of_parts,
+    az_json_reader_options const* options,
+    az_json_array_element_fn element_callback,
+    void* user_context,
+    az_json_array_run_tasks_fn run_tasks,
+    void* pool_context)
+{
+  _az_PRECONDITION(number_of_parts >= 0);
+  _az_PRECONDITION(number_of_parts == 0 || ref_parts != NULL);
+  _az_PRECONDITION_NOT_NULL(element_callback);
+
+  _az_json_array_parse_context context = {
+    .parts = ref_parts,
+    .options = options,
+    .element_callback = element_callback,
+    .user_context = user_context,
+  };
+
+  if (run_tasks == NULL)
+  {
+    for (int32_t i = 0; i < number_of_parts; i++)
+    {
+      _az_json_array_parse_part(&context, i);
+    }
+  }
+  else if (number_of_parts > 0)
+  {
+    run_tasks(pool_context, _az_json_array_parse_part, &context, number_of_parts);
+  }
+
+  for (int32_t i = 0; i < number_of_parts; i++)
+  {
+    _az_RETURN_IF_FAILED(ref_parts[i].result);
+  }
+
+  return AZ_OK;
+}
@@ -0,0 +1,273 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+// The 32-bit FNV-1a hash of the bytes of a property name.
+AZ_NODISCARD static uint32_t _az_json_bind_hash(az_span name)
+{
+  uint8_t const* const name_ptr = az_span_ptr(name);
+  int32_t const name_size = az_span_size(name);
+
+  uint32_t hash = 2166136261U;
+  for (int32_t i = 0; i < name_size; i++)
+  {
+    hash = (hash ^ name_ptr[i]) * 16777619U;
+  }
+  return hash;
+}
+
+// The slot of the index of a field with the given name hash, within the open addressing index of a
+// table, or the first empty slot probed if there is none.
+AZ_NODISCARD static int32_t _az_json_bind_find_slot(
+    az_json_bind_table const* table,
+    az_span name,
+    uint32_t hash)
+{
+  int32_t slot = (int32_t)(hash & (_az_JSON_BIND_TABLE_SLOTS - 1));
+
+  // The index has twice as many slots as there can be fields, so the probing always ends.
+  while (true)
+  {
+    int32_t const field_index = table->_internal.slots[slot] - 1;
+    if (field_index == -1
+        || (table->_internal.hashes[field_index] == hash
+            && az_span_is_content_equal(table->_internal.fields[field_index].name, name)))
+    {
+      return slot;
+    }
+    slot = (slot + 1) & (_az_JSON_BIND_TABLE_SLOTS - 1);
+  }
+}
+
+// Finds the field bound to a property name, returning -1 if there is none.
+AZ_NODISCARD static int32_t _az_json_bind_find_field(
+    az_json_bind_table const* table,
+    az_json_token const* property_name)
+{
+  // Names which need to be unescaped, or straddle buffers, can't be hashed in place, so compare
+  // them with each field name instead.
+  if (property_name->_internal.string_has_escaped_chars || property_name->_internal.is_multisegment)
+  {
+    for (int32_t i = 0; i < table->_internal.number_of_fields; i++)
+    {
+      if (az_json_token_is_text_equal(property_name, table->_internal.fields[i].name))
+      {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  int32_t const slot = _az_json_bind_find_slot(
+      table, property_name->slice, _az_json_bind_hash(property_name->slice));
+  return table->_internal.slots[slot] - 1;
+}
+
+AZ_NODISCARD az_result az_json_bind_table_init(
+    az_json_bind_table* out_table,
+    az_json_bind_field const fields[],
+    int32_t number_of_fields)
+{
+  _az_PRECONDITION_NOT_NULL(out_table);
+  _az_PRECONDITION_NOT_NULL(fields);
+  _az_PRECONDITION(number_of_fields >= 1);
+
+  // Each field has a bit in the masks of required and found fields.
+  if (number_of_fields > _az_JSON_BIND_MAX_FIELDS)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  *out_table = (az_json_bind_table){
+    ._internal = {
+      .fields = fields,
+      .number_of_fields = number_of_fields,
+      .required_fields = 0,
+      .hashes = { 0 },
+      .slots = { 0 },
+    },
+  };
+
+  for (int32_t i = 0; i < number_of_fields; i++)
+  {
+    uint32_t const hash = _az_json_bind_hash(fields[i].name);
+    int32_t const slot = _az_json_bind_find_slot(out_table, fields[i].name, hash);
+
+    // A name can only be bound to one field.
+    if (out_table->_internal.slots[slot] != 0)
+    {
+      return AZ_ERROR_ARG;
+    }
+
+    out_table->_internal.hashes[i] = hash;
+    out_table->_internal.slots[slot] = (int8_t)(i + 1);
+    if (fields[i].required)
+    {
+      out_table->_internal.required_fields |= 1U << (uint32_t)i;
+    }
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD static az_result _az_json_bind_read_value(
+    az_json_token const* value_token,
+    az_json_bind_field const* field,
+    uint8_t* member)
+{
+  switch (field->type)
+  {
+    case AZ_JSON_BIND_BOOLEAN:
+      return az_json_token_get_boolean(value_token, (bool*)(void*)member);
+    case AZ_JSON_BIND_INT32:
+      return az_json_token_get_int32(value_token, (int32_t*)(void*)member);
+    case AZ_JSON_BIND_UINT32:
+      return az_json_token_get_uint32(value_token, (uint32_t*)(void*)member);
+    case AZ_JSON_BIND_INT64:
+      return az_json_token_get_int64(value_token, (int64_t*)(void*)member);
+    case AZ_JSON_BIND_DOUBLE:
+      return az_json_token_get_double(value_token, (double*)(void*)member);
+    case AZ_JSON_BIND_STRING:
+    {
+      az_json_bind_string* const string = (az_json_bind_string*)(void*)member;
+
+      // There must at least be room for the null terminator.
+      if (az_span_size(string->buffer) == 0)
+      {
+        return value_token->kind == AZ_JSON_TOKEN_STRING ? AZ_ERROR_NOT_ENOUGH_SPACE
+                                                         : AZ_ERROR_JSON_INVALID_STATE;
+      }
+
+      return az_json_token_get_string(
+          value_token,
+          (char*)az_span_ptr(string->buffer),
+          az_span_size(string->buffer),
+          &string->length);
+    }
+    default:
+    {
+      _az_PRECONDITION(false);
+      return AZ_ERROR_ARG;
+    }
+  }
+}
+
+AZ_NODISCARD az_result az_json_bind_read(
+    az_json_reader* ref_json_reader,
+    az_json_bind_table const* table,
+    void* out_struct)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_reader);
+  _az_PRECONDITION_NOT_NULL(table);
+  _az_PRECONDITION_NOT_NULL(out_struct);
+
+  if (ref_json_reader->token.kind == AZ_JSON_TOKEN_NONE)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  }
+
+  if (ref_json_reader->token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  uint32_t found_fields = 0;
+  uint8_t* const struct_ptr = (uint8_t*)out_struct;
+
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  while (ref_json_reader->token.kind != AZ_JSON_TOKEN_END_OBJECT)
+  {
+    int32_t const field_index = _az_json_bind_find_field(table, &ref_json_reader->token);
+
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+
+    if (field_index == -1)
+    {
+      // The property isn't bound, so skip its value.
+      _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_json_reader));
+    }
+    else
+    {
+      az_json_bind_field const* const field = &table->_internal.fields[field_index];
+      _az_RETURN_IF_FAILED(
+          _az_json_bind_read_value(&ref_json_reader->token, field, struct_ptr + field->offset));
+      found_fields |= 1U << (uint32_t)field_index;
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  }
+
+  if ((table->_internal.required_fields & ~found_fields) != 0)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD static az_result _az_json_bind_write_value(
+    az_json_writer* ref_json_writer,
+    az_json_bind_field const* field,
+    uint8_t const* member)
+{
+  switch (field->type)
+  {
+    case AZ_JSON_BIND_BOOLEAN:
+      return az_json_writer_append_bool(ref_json_writer, *(bool const*)(void const*)member);
+    case AZ_JSON_BIND_INT32:
+      return az_json_writer_append_int32(ref_json_writer, *(int32_t const*)(void const*)member);
+    case AZ_JSON_BIND_UINT32:
+      return az_json_writer_append_int64(ref_json_writer, *(uint32_t const*)(void const*)member);
+    case AZ_JSON_BIND_INT64:
+      return az_json_writer_append_int64(ref_json_writer, *(int64_t const*)(void const*)member);
+    case AZ_JSON_BIND_DOUBLE:
+    {
+      double const value = *(double const*)(void const*)member;
+      if (field->fractional_digits == AZ_JSON_BIND_DOUBLE_SHORTEST)
+      {
+        return az_json_writer_append_double_shortest(ref_json_writer, value);
+      }
+      return az_json_writer_append_double(ref_json_writer, value, field->fractional_digits);
+    }
+    case AZ_JSON_BIND_STRING:
+    {
+      az_json_bind_string const* const string = (az_json_bind_string const*)(void const*)member;
+      return az_json_writer_append_string(
+          ref_json_writer, az_span_slice(string->buffer, 0, string->length));
+    }
+    default:
+    {
+      _az_PRECONDITION(false);
+      return AZ_ERROR_ARG;
+    }
+  }
+}
+
+AZ_NODISCARD az_result az_json_bind_write(
+    az_json_writer* ref_json_writer,
+    az_json_bind_table const* table,
+    void const* value_struct)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_NOT_NULL(table);
+  _az_PRECONDITION_NOT_NULL(value_struct);
+
+  az_json_bind_field const* const fields = table->_internal.fields;
+  uint8_t const* const struct_ptr = (uint8_t const*)value_struct;
+
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(ref_json_writer));
+  for (int32_t i = 0; i < table->_internal.number_of_fields; i++)
+  {
+    _az_RETURN_IF_FAILED(az_json_writer_append_property_name(ref_json_writer, fields[i].name));
+    _az_RETURN_IF_FAILED(
+        _az_json_bind_write_value(ref_json_writer, &fields[i], struct_ptr + fields[i].offset));
+  }
+  return az_json_writer_append_end_object(ref_json_writer);
+}
@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_json_document_parse(
+    az_json_document* out_json_document,
+    az_span json_buffer,
+    az_json_document_record records[],
+    int32_t records_size,
+    az_json_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_document);
+  _az_PRECONDITION_NOT_NULL(records);
+  _az_PRECONDITION(records_size > 0);
+
+  *out_json_document = (az_json_document){
+    ._internal = {
+      .json_buffer = json_buffer,
+      .records = records,
+      .number_of_records = 0,
+    },
+  };
+
+  az_json_reader reader = { 0 };
+  _az_RETURN_IF_FAILED(az_json_reader_init(&reader, json_buffer, options));
+
+  int32_t count = 0;
+
+  // The index of the start of the object or array containing the current token.
+  int32_t parent_index = -1;
+
+  while (true)
+  {
+    az_result const result = az_json_reader_next_token(&reader);
+    if (result == AZ_ERROR_JSON_READER_DONE)
+    {
+      break;
+    }
+    _az_RETURN_IF_FAILED(result);
+
+    if (count >= records_size)
+    {
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
+    az_json_token const* const token = &reader.token;
+    az_json_document_record* const record = &records[count];
+
+    record->_internal.offset = (int32_t)(az_span_ptr(token->slice) - az_span_ptr(json_buffer));
+    record->_internal.size = az_span_size(token->slice);
+    record->_internal.link_index = -1;
+    record->_internal.parent_index = parent_index;
+    record->_internal.kind = (uint8_t)token->kind;
+    record->_internal.string_has_escaped_chars = token->_internal.string_has_escaped_chars;
+
+    switch (token->kind)
+    {
+      case AZ_JSON_TOKEN_BEGIN_OBJECT:
+      case AZ_JSON_TOKEN_BEGIN_ARRAY:
+      {
+        parent_index = count;
+        break;
+      }
+      case AZ_JSON_TOKEN_END_OBJECT:
+      case AZ_JSON_TOKEN_END_ARRAY:
+      {
+        // The end of an object or array is at the same level as its start.
+        az_json_document_record* const begin_record = &records[parent_index];
+        begin_record->_internal.link_index = count;
+        record->_internal.link_index = parent_index;
+        record->_internal.parent_index = begin_record->_internal.parent_index;
+        parent_index = begin_record->_internal.parent_index;
+        break;
+      }
+      default:
+      {
+        break;
+      }
+    }
+
+    count++;
+  }
+
+  out_json_document->_internal.number_of_records = count;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_json_token
+az_json_document_get_token(az_json_document const* json_document, int32_t index)
+{
+  _az_PRECONDITION_NOT_NULL(json_document);
+  _az_PRECONDITION_RANGE(0, index, json_document->_internal.number_of_records - 1);
+
+  az_json_document_record const* const record = &json_document->_internal.records[index];
+  int32_t const start_offset = record->_internal.offset;
+  int32_t const end_offset = start_offset + record->_internal.size;
+
+  return (az_json_token){
+    .slice = az_span_slice(json_document->_internal.json_buffer, start_offset, end_offset),
+    .kind = (az_json_token_kind)record->_internal.kind,
+    .size = record->_internal.size,
+    ._internal = {
+      .is_multisegment = false,
+      .string_has_escaped_chars = record->_internal.string_has_escaped_chars,
+      .pointer_to_first_buffer = &AZ_SPAN_EMPTY,
+      .start_buffer_index = -1,
+      .start_buffer_offset = -1,
+      .end_buffer_index = 0,
+      .end_buffer_offset = end_offset,
+    },
+  };
+}
+
+AZ_NODISCARD az_result az_json_document_get_parent(
+    az_json_document const* json_document,
+    int32_t index,
+    int32_t* out_index)
+{
+  _az_PRECONDITION_NOT_NULL(json_document);
+  _az_PRECONDITION_RANGE(0, index, json_document->_internal.number_of_records - 1);
+  _az_PRECONDITION_NOT_NULL(out_index);
+
+  int32_t const parent_index = json_document->_internal.records[index]._internal.parent_index;
+  if (parent_index == -1)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  *out_index = parent_index;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_document_get_first_child(
+    az_json_document const* json_document,
+    int32_t index,
+    int32_t* out_index)
+{
+  _az_PRECONDITION_NOT_NULL(json_document);
+  _az_PRECONDITION_RANGE(0, index, json_document->_internal.number_of_records - 1);
+  _az_PRECONDITION_NOT_NULL(out_index);
+
+  az_json_document_record const* const record = &json_document->_internal.records[index];
+  _az_PRECONDITION(
+      record->_internal.kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+      || record->_internal.kind == AZ_JSON_TOKEN_BEGIN_ARRAY);
+
+  // An empty object or array is immediately followed by its end.
+  if (record->_internal.link_index == index + 1)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  *out_index = index + 1;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_document_get_next_sibling(
+    az_json_document const* json_document,
+    int32_t index,
+    int32_t* out_index)
+{
+  _az_PRECONDITION_NOT_NULL(json_document);
+  _az_PRECONDITION_RANGE(0, index, json_document->_internal.number_of_records - 1);
+  _az_PRECONDITION_NOT_NULL(out_index);
+
+  az_json_document_record const* const records = json_document->_internal.records;
+
+  // Move from a property name to its value, and then past the end of that value.
+  int32_t next_index = index;
+  if (records[next_index]._internal.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    next_index++;
+  }
+
+  uint8_t const kind = records[next_index]._internal.kind;
+  if (kind == AZ_JSON_TOKEN_BEGIN_OBJECT || kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
+  {
+    next_index = records[next_index]._internal.link_index;
+  }
+  next_index++;
+
+  // The root JSON value has no siblings, and the last sibling is followed by the end of its parent.
+  if (next_index >= json_document->_internal.number_of_records
+      || records[next_index]._internal.kind == AZ_JSON_TOKEN_END_OBJECT
+      || records[next_index]._internal.kind == AZ_JSON_TOKEN_END_ARRAY)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  *out_index = next_index;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_document_find_property(
+    az_json_document const* json_document,
+    int32_t index,
+    az_span property_name,
+    int32_t* out_index)
+{
+  _az_PRECONDITION_NOT_NULL(json_document);
+  _az_PRECONDITION_RANGE(0, index, json_document->_internal.number_of_records - 1);
+  _az_PRECONDITION(
+      json_document->_internal.records[index]._internal.kind == AZ_JSON_TOKEN_BEGIN_OBJECT);
+  _az_PRECONDITION_NOT_NULL(out_index);
+
+  int32_t child_index = 0;
+  az_result result = az_json_document_get_first_child(json_document, index, &child_index);
+  while (az_result_succeeded(result))
+  {
+    az_json_token const name = az_json_document_get_token(json_document, child_index);
+    if (az_json_token_is_text_equal(&name, property_name))
+    {
+      *out_index = child_index + 1;
+      return AZ_OK;
+    }
+
+    result = az_json_document_get_next_sibling(json_document, child_index, &child_index);
+  }
+
+  return AZ_ERROR_ITEM_NOT_FOUND;
+}
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_simd_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_json_lines_reader_init(
+    az_json_lines_reader* out_json_lines_reader,
+    az_span json_lines,
+    int32_t offset,
+    bool is_final,
+    az_json_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_lines_reader);
+  _az_PRECONDITION_VALID_SPAN(json_lines, 0, true);
+  _az_PRECONDITION_RANGE(0, offset, az_span_size(json_lines));
+
+  *out_json_lines_reader = (az_json_lines_reader){
+    ._internal = {
+      .json_lines = json_lines,
+      .offset = offset,
+      .is_final = is_final,
+      .options = options == NULL ? az_json_reader_options_default() : *options,
+    },
+  };
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_lines_reader_next_record(
+    az_json_lines_reader* ref_json_lines_reader,
+    az_json_reader* out_json_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_lines_reader);
+  _az_PRECONDITION_NOT_NULL(out_json_reader);
+
+  az_span const json_lines = ref_json_lines_reader->_internal.json_lines;
+  int32_t const json_lines_size = az_span_size(json_lines);
+  uint8_t const* const json_lines_ptr = az_span_ptr(json_lines);
+  int32_t offset = ref_json_lines_reader->_internal.offset;
+
+  while (offset < json_lines_size)
+  {
+    int32_t const line_size
+        = _az_simd_count_bytes_before(json_lines_ptr + offset, json_lines_size - offset, '\n');
+
+    // The '\r' of a "\r\n" line ending is whitespace, and is trimmed along with the rest of it.
+    az_span const record
+        = _az_span_trim_whitespace(az_span_slice(json_lines, offset, offset + line_size));
+
+    bool const is_line_ended = line_size < json_lines_size - offset;
+
+    // The last line of a window may be the start of a record which continues in the next one.
+    if (!is_line_ended && !ref_json_lines_reader->_internal.is_final)
+    {
+      ref_json_lines_reader->_internal.offset = offset;
+      return az_span_size(record) > 0 ? AZ_ERROR_UNEXPECTED_END : AZ_ERROR_JSON_READER_DONE;
+    }
+
+    offset += is_line_ended ? line_size + 1 : line_size;
+
+    if (az_span_size(record) > 0)
+    {
+      ref_json_lines_reader->_internal.offset = offset;
+      return az_json_reader_init(
+          out_json_reader, record, &ref_json_lines_reader->_internal.options);
+    }
+  }
+
+  ref_json_lines_reader->_internal.offset = offset;
+  return AZ_ERROR_JSON_READER_DONE;
+}
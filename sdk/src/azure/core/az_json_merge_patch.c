@@ -0,0 +1,384 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD static bool _az_json_merge_patch_is_name_equal(
+    az_json_token const* first_name,
+    az_json_token const* second_name)
+{
+  // When at least one of the names isn't escaped, it can be compared as it is written. Otherwise,
+  // both are unescaped, since the same name can be escaped in different ways, such as "a\/b" and
+  // "a\u002fb".
+  if (!second_name->_internal.string_has_escaped_chars)
+  {
+    return az_json_token_is_text_equal(first_name, second_name->slice);
+  }
+  if (!first_name->_internal.string_has_escaped_chars)
+  {
+    return az_json_token_is_text_equal(second_name, first_name->slice);
+  }
+  return _az_json_token_is_unescaped_text_equal(first_name, second_name);
+}
+
+// Finds the property with the given name within the object that starts at the current token of the
+// reader, and sets out_value_reader to a reader at its value.
+AZ_NODISCARD static az_result _az_json_merge_patch_find_property(
+    az_json_reader const* object_reader,
+    az_json_token const* name,
+    az_json_reader* out_value_reader,
+    bool* out_found)
+{
+  *out_value_reader = *object_reader;
+  *out_found = false;
+
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(out_value_reader));
+    if (out_value_reader->token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      return AZ_OK;
+    }
+
+    bool const is_match = _az_json_merge_patch_is_name_equal(&out_value_reader->token, name);
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(out_value_reader));
+    if (is_match)
+    {
+      *out_found = true;
+      return AZ_OK;
+    }
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(out_value_reader));
+  }
+}
+
+// Compares the values at the current tokens of both readers, token by token, so that members of
+// objects which are in a different order make them different. The readers are moved past the first
+// difference, and must not be used afterwards.
+AZ_NODISCARD static az_result _az_json_merge_patch_is_value_equal(
+    az_json_reader* ref_first_reader,
+    az_json_reader* ref_second_reader,
+    bool* out_is_equal)
+{
+  az_json_token_kind const kind = ref_first_reader->token.kind;
+  bool const is_container = kind == AZ_JSON_TOKEN_BEGIN_OBJECT || kind == AZ_JSON_TOKEN_BEGIN_ARRAY;
+  int32_t const depth = ref_first_reader->_internal.bit_stack._internal.current_depth;
+
+  *out_is_equal = false;
+  while (true)
+  {
+    az_json_token const* const first_token = &ref_first_reader->token;
+    az_json_token const* const second_token = &ref_second_reader->token;
+    if (first_token->kind != second_token->kind
+        || !az_span_is_content_equal(first_token->slice, second_token->slice))
+    {
+      return AZ_OK;
+    }
+
+    if (!is_container || ref_first_reader->_internal.bit_stack._internal.current_depth < depth)
+    {
+      *out_is_equal = true;
+      return AZ_OK;
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_first_reader));
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_second_reader));
+  }
+}
+
+// Writes the object at the current token of the reader, leaving out the properties whose value is
+// null, within it and within the objects it contains, which is the same as merging it into an
+// empty object.
+AZ_NODISCARD static az_result _az_json_merge_patch_append_without_nulls(
+    az_json_reader* ref_patch_reader,
+    az_json_writer* ref_json_writer)
+{
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(ref_json_writer));
+
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_patch_reader));
+    if (ref_patch_reader->token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      return az_json_writer_append_end_object(ref_json_writer);
+    }
+
+    az_span const name = ref_patch_reader->token.slice;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_patch_reader));
+
+    az_json_token_kind const value_kind = ref_patch_reader->token.kind;
+    if (value_kind == AZ_JSON_TOKEN_NULL)
+    {
+      continue;
+    }
+
+    _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name));
+    _az_RETURN_IF_FAILED(
+        value_kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+            ? _az_json_merge_patch_append_without_nulls(ref_patch_reader, ref_json_writer)
+            : _az_json_writer_append_reader_value(ref_json_writer, ref_patch_reader));
+  }
+}
+
+// Merges the patch object at the current token of patch_reader into the base object at the
+// current token of the base reader, which is moved to the end of the base object.
+AZ_NODISCARD static az_result _az_json_merge_patch_apply_object(
+    az_json_reader* ref_base_reader,
+    az_json_reader const* patch_reader,
+    az_json_writer* ref_json_writer)
+{
+  az_json_reader const base_object_reader = *ref_base_reader;
+
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(ref_json_writer));
+
+  // The properties of the base object are kept, replaced, merged or removed, in their order.
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_base_reader));
+    if (ref_base_reader->token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      break;
+    }
+
+    az_json_token const name = ref_base_reader->token;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_base_reader));
+
+    az_json_reader patch_value_reader = { 0 };
+    bool found = false;
+    _az_RETURN_IF_FAILED(
+        _az_json_merge_patch_find_property(patch_reader, &name, &patch_value_reader, &found));
+
+    if (!found)
+    {
+      _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name.slice));
+      _az_RETURN_IF_FAILED(_az_json_writer_append_reader_value(ref_json_writer, ref_base_reader));
+      continue;
+    }
+
+    az_json_token_kind const patch_kind = patch_value_reader.token.kind;
+    if (patch_kind == AZ_JSON_TOKEN_NULL)
+    {
+      _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_base_reader));
+      continue;
+    }
+
+    _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name.slice));
+
+    if (patch_kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+        && ref_base_reader->token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
+    {
+      _az_RETURN_IF_FAILED(
+          _az_json_merge_patch_apply_object(ref_base_reader, &patch_value_reader, ref_json_writer));
+      continue;
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_base_reader));
+    _az_RETURN_IF_FAILED(
+        patch_kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+            ? _az_json_merge_patch_append_without_nulls(&patch_value_reader, ref_json_writer)
+            : _az_json_writer_append_reader_value(ref_json_writer, &patch_value_reader));
+  }
+
+  // The properties of the patch which aren't within the base object are added, after the others.
+  az_json_reader patch_member_reader = *patch_reader;
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&patch_member_reader));
+    if (patch_member_reader.token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      break;
+    }
+
+    az_json_token const name = patch_member_reader.token;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&patch_member_reader));
+
+    az_json_reader base_value_reader = { 0 };
+    bool found = false;
+    _az_RETURN_IF_FAILED(
+        _az_json_merge_patch_find_property(&base_object_reader, &name, &base_value_reader, &found));
+
+    az_json_token_kind const patch_kind = patch_member_reader.token.kind;
+    if (found || patch_kind == AZ_JSON_TOKEN_NULL)
+    {
+      _az_RETURN_IF_FAILED(az_json_reader_skip_children(&patch_member_reader));
+      continue;
+    }
+
+    _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name.slice));
+    _az_RETURN_IF_FAILED(
+        patch_kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+            ? _az_json_merge_patch_append_without_nulls(&patch_member_reader, ref_json_writer)
+            : _az_json_writer_append_reader_value(ref_json_writer, &patch_member_reader));
+  }
+
+  return az_json_writer_append_end_object(ref_json_writer);
+}
+
+AZ_NODISCARD static az_result _az_json_merge_patch_move_to_value(az_json_reader* ref_json_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_reader);
+  // Values are copied as is from the text read, which must all be within a single buffer.
+  _az_PRECONDITION(ref_json_reader->_internal.number_of_buffers == 1);
+
+  az_json_token_kind const token_kind = ref_json_reader->token.kind;
+  if (token_kind == AZ_JSON_TOKEN_NONE || token_kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    return az_json_reader_next_token(ref_json_reader);
+  }
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_merge_patch_apply(
+    az_json_reader* ref_base_reader,
+    az_json_reader* ref_patch_reader,
+    az_json_writer* ref_json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+
+  _az_RETURN_IF_FAILED(_az_json_merge_patch_move_to_value(ref_base_reader));
+  _az_RETURN_IF_FAILED(_az_json_merge_patch_move_to_value(ref_patch_reader));
+
+  // A patch which isn't an object replaces the base value.
+  if (ref_patch_reader->token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_base_reader));
+    return _az_json_writer_append_reader_value(ref_json_writer, ref_patch_reader);
+  }
+
+  // A base value which isn't an object is replaced by an empty object before merging.
+  if (ref_base_reader->token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_base_reader));
+    return _az_json_merge_patch_append_without_nulls(ref_patch_reader, ref_json_writer);
+  }
+
+  az_json_reader const patch_object_reader = *ref_patch_reader;
+  _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_patch_reader));
+  return _az_json_merge_patch_apply_object(ref_base_reader, &patch_object_reader, ref_json_writer);
+}
+
+// Writes the patch which turns the source object at the current token of source_reader into the
+// target object at the current token of the target reader, which is moved to the end of the target
+// object.
+AZ_NODISCARD static az_result _az_json_merge_patch_create_object(
+    az_json_reader const* source_reader,
+    az_json_reader* ref_target_reader,
+    az_json_writer* ref_json_writer)
+{
+  az_json_reader const target_object_reader = *ref_target_reader;
+
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(ref_json_writer));
+
+  // The properties of the source object which aren't within the target object are removed.
+  az_json_reader source_member_reader = *source_reader;
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&source_member_reader));
+    if (source_member_reader.token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      break;
+    }
+
+    az_json_token const name = source_member_reader.token;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&source_member_reader));
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(&source_member_reader));
+
+    az_json_reader target_value_reader = { 0 };
+    bool found = false;
+    _az_RETURN_IF_FAILED(_az_json_merge_patch_find_property(
+        &target_object_reader, &name, &target_value_reader, &found));
+
+    if (!found)
+    {
+      _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name.slice));
+      _az_RETURN_IF_FAILED(az_json_writer_append_null(ref_json_writer));
+    }
+  }
+
+  // The properties of the target object are added, or replaced when their value changed.
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_target_reader));
+    if (ref_target_reader->token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      break;
+    }
+
+    az_json_token const name = ref_target_reader->token;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_target_reader));
+
+    az_json_reader source_value_reader = { 0 };
+    bool found = false;
+    _az_RETURN_IF_FAILED(
+        _az_json_merge_patch_find_property(source_reader, &name, &source_value_reader, &found));
+
+    if (found && source_value_reader.token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+        && ref_target_reader->token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
+    {
+      // Objects are patched property by property, and left out when nothing within them changed.
+      az_json_writer_checkpoint const checkpoint = az_json_writer_get_checkpoint(ref_json_writer);
+      _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name.slice));
+      int32_t const size_before_value = az_json_writer_get_total_bytes_written(ref_json_writer);
+
+      _az_RETURN_IF_FAILED(_az_json_merge_patch_create_object(
+          &source_value_reader, ref_target_reader, ref_json_writer));
+
+      // For the '{' and '}' of an empty object.
+      if (az_json_writer_get_total_bytes_written(ref_json_writer) - size_before_value == 2)
+      {
+        az_json_writer_rollback(ref_json_writer, &checkpoint);
+      }
+      continue;
+    }
+
+    if (found)
+    {
+      az_json_reader target_value_reader = *ref_target_reader;
+      bool is_equal = false;
+      _az_RETURN_IF_FAILED(_az_json_merge_patch_is_value_equal(
+          &source_value_reader, &target_value_reader, &is_equal));
+      if (is_equal)
+      {
+        _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_target_reader));
+        continue;
+      }
+    }
+
+    _az_RETURN_IF_FAILED(_az_json_writer_append_raw_property_name(ref_json_writer, name.slice));
+    _az_RETURN_IF_FAILED(_az_json_writer_append_reader_value(ref_json_writer, ref_target_reader));
+  }
+
+  return az_json_writer_append_end_object(ref_json_writer);
+}
+
+AZ_NODISCARD az_result az_json_merge_patch_create(
+    az_json_reader* ref_source_reader,
+    az_json_reader* ref_target_reader,
+    az_json_writer* ref_json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  // Objects within which nothing changed are rolled back to a checkpoint, which needs the text
+  // written since then to still be within the destination buffer.
+  _az_PRECONDITION(ref_json_writer->_internal.allocator_callback == NULL);
+
+  _az_RETURN_IF_FAILED(_az_json_merge_patch_move_to_value(ref_source_reader));
+  _az_RETURN_IF_FAILED(_az_json_merge_patch_move_to_value(ref_target_reader));
+
+  // Unless both values are objects, the patch is the target value itself.
+  if (ref_source_reader->token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT
+      || ref_target_reader->token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_source_reader));
+    return _az_json_writer_append_reader_value(ref_json_writer, ref_target_reader);
+  }
+
+  az_json_reader const source_object_reader = *ref_source_reader;
+  _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_source_reader));
+  return _az_json_merge_patch_create_object(
+      &source_object_reader, ref_target_reader, ref_json_writer);
+}
@@ -15,6 +15,23 @@
     .kind = AZ_JSON_TOKEN_NONE, ._internal = { 0 } \
   }
 
+// The bits of az_json_token._internal.number_flags.
+enum
+{
+  // The number was captured while reading the token, so the other flags describe it.
+  _az_JSON_NUMBER_CAPTURED = 0x01,
+
+  // The number starts with a '-' sign.
+  _az_JSON_NUMBER_IS_NEGATIVE = 0x02,
+
+  // The number has neither a fraction nor an exponent.
+  _az_JSON_NUMBER_IS_INTEGER = 0x04,
+
+  // The number is an integer with few enough digits that its absolute value is within
+  // az_json_token._internal.number_magnitude.
+  _az_JSON_NUMBER_HAS_MAGNITUDE = 0x08,
+};
+
 enum
 {
   // We are using a uint64_t to represent our nested state, so we can only go 64 levels deep.
@@ -58,6 +75,23 @@ enum
 
   // The number of unique values in base 16 (hexadecimal).
   _az_NUMBER_OF_HEX_VALUES = 16,
+
+  // Characters outside of the basic multilingual plane are escaped as a pair of UTF-16 code units,
+  // a high surrogate followed by a low surrogate, such as \uD83D\uDE00.
+  _az_UTF16_HIGH_SURROGATE_START = 0xD800,
+  _az_UTF16_LOW_SURROGATE_START = 0xDC00,
+  _az_UTF16_LOW_SURROGATE_END = 0xDFFF,
+  _az_UTF16_SUPPLEMENTARY_PLANE_START = 0x10000,
+
+  // U+FFFD, which replaces a surrogate that isn't part of a pair when unescaping.
+  _az_UNICODE_REPLACEMENT_CHARACTER = 0xFFFD,
+
+  // The number of JSON pointer paths that can be looked up within a single pass over the JSON text.
+  _az_MAX_JSON_PATHS = 16,
+
+  // The largest JSON pointer path segment containing '~0' or '~1' escapes that can be decoded
+  // before being compared to a property name.
+  _az_MAX_JSON_POINTER_ESCAPED_SEGMENT_SIZE = 64,
 };
 
 typedef enum
@@ -109,6 +143,77 @@ AZ_NODISCARD AZ_INLINE _az_json_stack_item _az_json_stack_peek(_az_json_bit_stac
                                                          : _az_JSON_STACK_ARRAY;
 }
 
+/**
+ * @brief Returns the length of the JSON string within \p value after it has been escaped, and sets
+ * \p out_index_of_first_escaped_char to the index of the first character to escape, or -1 if there
+ * are none. If \p break_on_first_escaped is true, it returns as soon as that character is found.
+ */
+int32_t _az_json_writer_escaped_length(
+    az_span value,
+    int32_t* out_index_of_first_escaped_char,
+    bool break_on_first_escaped);
+
+/**
+ * @brief Copies \p source into \p destination, escaping the characters that need to be escaped
+ * within a JSON string, and returns the remainder of \p destination.
+ *
+ * @remarks \p destination must be large enough for the escaped text.
+ */
+AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination, az_span source);
+
+/**
+ * @brief Appends JSON text which is already known to be a complete, valid and escaped JSON value,
+ * such as a value copied as is from the text read by an #az_json_reader, without validating it
+ * again. \p last_token_kind is the kind of its last token.
+ */
+AZ_NODISCARD az_result _az_json_writer_append_raw_value(
+    az_json_writer* ref_json_writer,
+    az_span json_text,
+    az_json_token_kind last_token_kind);
+
+/**
+ * @brief Appends the current value of \p ref_json_reader, which must read a single buffer, as is,
+ * and moves the reader to the last token of that value.
+ */
+AZ_NODISCARD az_result _az_json_writer_append_reader_value(
+    az_json_writer* ref_json_writer,
+    az_json_reader* ref_json_reader);
+
+/**
+ * @brief Appends a property name which is already escaped, such as the text of a property name
+ * token read by an #az_json_reader, without escaping it again.
+ */
+AZ_NODISCARD az_result
+_az_json_writer_append_raw_property_name(az_json_writer* ref_json_writer, az_span escaped_name);
+
+/**
+ * @brief Returns the offset of the '/' which ends the JSON pointer segment starting right after
+ * the '/' at \p slash_offset, or the size of \p path if it is the last segment.
+ */
+AZ_NODISCARD int32_t _az_json_pointer_segment_end(az_span path, int32_t slash_offset);
+
+/**
+ * @brief Returns the offset of the '/' which starts the JSON pointer segment ending at
+ * \p slash_offset.
+ */
+AZ_NODISCARD int32_t _az_json_pointer_segment_start(az_span path, int32_t slash_offset);
+
+/**
+ * @brief Returns whether the property name \p json_token is equal to the JSON pointer path
+ * \p segment, once its '~0' and '~1' escapes are decoded.
+ */
+AZ_NODISCARD bool _az_json_token_is_pointer_segment_equal(
+    az_json_token const* json_token,
+    az_span segment);
+
+/**
+ * @brief Returns whether the string or property name tokens \p first_token and \p second_token
+ * have the same text, once both of them are unescaped.
+ */
+AZ_NODISCARD bool _az_json_token_is_unescaped_text_equal(
+    az_json_token const* first_token,
+    az_json_token const* second_token);
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_SPAN_PRIVATE_H
@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_json_push_reader_init(
+    az_json_push_reader* out_json_push_reader,
+    az_span carry_buffer,
+    az_json_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_push_reader);
+  _az_PRECONDITION(az_span_size(carry_buffer) >= 1);
+
+  *out_json_push_reader = (az_json_push_reader){
+    .token = _az_JSON_TOKEN_DEFAULT,
+    ._internal = {
+      .segments = { AZ_SPAN_EMPTY, AZ_SPAN_EMPTY },
+      .carry_buffer = carry_buffer,
+      .carried = AZ_SPAN_EMPTY,
+      .options = options == NULL ? az_json_reader_options_default() : *options,
+      .has_fragment = false,
+      .has_carried = false,
+      .is_final_fragment = false,
+    },
+  };
+
+  // The reader is pointed at the fragments as they are provided.
+  return az_json_reader_chunked_init(
+      &out_json_push_reader->_internal.reader,
+      &out_json_push_reader->_internal.carry_buffer,
+      1,
+      &out_json_push_reader->_internal.options);
+}
+
+// Points the reader at the current segments, in case the push reader was copied since.
+static void _az_json_push_reader_attach_segments(az_json_push_reader* ref_json_push_reader)
+{
+  az_json_reader* const reader = &ref_json_push_reader->_internal.reader;
+  reader->_internal.json_buffers = ref_json_push_reader->_internal.segments;
+  reader->_internal.json_buffer
+      = ref_json_push_reader->_internal.segments[reader->_internal.buffer_index];
+  reader->token._internal.pointer_to_first_buffer = ref_json_push_reader->_internal.segments;
+}
+
+AZ_NODISCARD static az_span _az_json_push_reader_skip_whitespace(az_span json)
+{
+  int32_t const json_size = az_span_size(json);
+  uint8_t const* const json_ptr = az_span_ptr(json);
+
+  int32_t i = 0;
+  while (i < json_size)
+  {
+    uint8_t const next_byte = json_ptr[i];
+    if (next_byte != ' ' && next_byte != '\t' && next_byte != '\n' && next_byte != '\r')
+    {
+      break;
+    }
+    i++;
+  }
+  return az_span_slice_to_end(json, i);
+}
+
+// Copies the bytes which haven't been read yet into the carry-over buffer, so that the current
+// fragment is no longer needed. The segments are left as they are until the next fragment is
+// provided, so that the tokens returned so far remain valid until then.
+AZ_NODISCARD static az_result _az_json_push_reader_carry_over(
+    az_json_push_reader* ref_json_push_reader)
+{
+  az_json_reader const* const reader = &ref_json_push_reader->_internal.reader;
+  az_span const* const segments = ref_json_push_reader->_internal.segments;
+  az_span const carry_buffer = ref_json_push_reader->_internal.carry_buffer;
+
+  // Gather the unread bytes, from the current segment onwards.
+  az_span unread[2] = { AZ_SPAN_EMPTY, AZ_SPAN_EMPTY };
+  int32_t const buffer_index = reader->_internal.buffer_index;
+  unread[0] = az_span_slice_to_end(segments[buffer_index], reader->_internal.bytes_consumed);
+  if (buffer_index + 1 < reader->_internal.number_of_buffers)
+  {
+    unread[1] = segments[buffer_index + 1];
+  }
+
+  // Whitespace between tokens doesn't need to be kept.
+  for (int32_t i = 0; i < 2; i++)
+  {
+    unread[i] = _az_json_push_reader_skip_whitespace(unread[i]);
+    if (az_span_size(unread[i]) > 0)
+    {
+      break;
+    }
+  }
+
+  // Once the reader is past the carried-over bytes, the first token returned since the last
+  // fragment was provided starts within them, so the unread bytes are copied after them. Otherwise,
+  // no token returned refers to the carry-over buffer, and the unread bytes within it are moved to
+  // its start, before those of the current fragment are appended.
+  int32_t const carry_offset = buffer_index > 0 ? az_span_size(segments[0]) : 0;
+  int32_t const carry_size = az_span_size(unread[0]) + az_span_size(unread[1]);
+  if (carry_offset + carry_size > az_span_size(carry_buffer))
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  az_span const destination = az_span_slice_to_end(carry_buffer, carry_offset);
+  az_span_copy(az_span_copy(destination, unread[0]), unread[1]);
+
+  ref_json_push_reader->_internal.carried = az_span_slice(destination, 0, carry_size);
+  ref_json_push_reader->_internal.has_carried = true;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_push_reader_feed(
+    az_json_push_reader* ref_json_push_reader,
+    az_span fragment,
+    bool is_final_fragment)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_push_reader);
+  _az_PRECONDITION(!ref_json_push_reader->_internal.is_final_fragment);
+  // Any unread bytes of the previous fragments are already within the carry-over buffer.
+  _az_PRECONDITION(
+      !ref_json_push_reader->_internal.has_fragment || ref_json_push_reader->_internal.has_carried);
+
+  az_json_reader* const reader = &ref_json_push_reader->_internal.reader;
+  az_span* const segments = ref_json_push_reader->_internal.segments;
+
+  // The tokens returned so far are no longer used, so the carried-over bytes can be moved to the
+  // start of the buffer, and become the start of the text to read.
+  az_span const carry_buffer = ref_json_push_reader->_internal.carry_buffer;
+  az_span const carried = ref_json_push_reader->_internal.carried;
+  az_span_copy(carry_buffer, carried);
+  segments[0] = az_span_slice(carry_buffer, 0, az_span_size(carried));
+  segments[1] = AZ_SPAN_EMPTY;
+  ref_json_push_reader->_internal.carried = AZ_SPAN_EMPTY;
+  ref_json_push_reader->_internal.has_carried = false;
+
+  reader->_internal.number_of_buffers = 1;
+  reader->_internal.bytes_consumed = 0;
+
+  if (az_span_size(segments[0]) == 0)
+  {
+    segments[0] = fragment;
+  }
+  else if (az_span_size(fragment) > 0)
+  {
+    segments[1] = fragment;
+    reader->_internal.number_of_buffers = 2;
+  }
+
+  reader->_internal.buffer_index = 0;
+  _az_json_push_reader_attach_segments(ref_json_push_reader);
+
+  ref_json_push_reader->_internal.has_fragment = true;
+  ref_json_push_reader->_internal.is_final_fragment = is_final_fragment;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_push_reader_next_token(az_json_push_reader* ref_json_push_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_push_reader);
+
+  // Nothing more can be read until the next fragment is provided.
+  if (!ref_json_push_reader->_internal.has_fragment || ref_json_push_reader->_internal.has_carried)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  _az_json_push_reader_attach_segments(ref_json_push_reader);
+
+  az_json_reader* const reader = &ref_json_push_reader->_internal.reader;
+  az_json_reader const previous_reader = *reader;
+
+  az_result const result = az_json_reader_next_token(reader);
+
+  if (!ref_json_push_reader->_internal.is_final_fragment)
+  {
+    // A number which ends with the text provided so far could have more digits in the next
+    // fragment.
+    bool const is_incomplete_number = az_result_succeeded(result)
+        && reader->token.kind == AZ_JSON_TOKEN_NUMBER
+        && reader->_internal.buffer_index == reader->_internal.number_of_buffers - 1
+        && reader->_internal.bytes_consumed == az_span_size(reader->_internal.json_buffer);
+
+    if (result == AZ_ERROR_UNEXPECTED_END || is_incomplete_number)
+    {
+      *reader = previous_reader;
+      _az_RETURN_IF_FAILED(_az_json_push_reader_carry_over(ref_json_push_reader));
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+  }
+
+  _az_RETURN_IF_FAILED(result);
+
+  ref_json_push_reader->token = reader->token;
+  return AZ_OK;
+}
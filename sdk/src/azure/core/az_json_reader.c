@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "az_json_private.h"
+#include "az_simd_private.h"
 #include "az_span_private.h"
 #include <azure/core/az_precondition.h>
 #include <azure/core/internal/az_result_internal.h>
@@ -265,8 +266,48 @@ AZ_NODISCARD static az_result _az_json_reader_process_string(az_json_reader* ref
   // Clear the state of any previous string token.
   ref_json_reader->token._internal.string_has_escaped_chars = false;
 
+  bool const validate_utf8 = ref_json_reader->_internal.options.validate_utf8;
+  _az_utf8_validator utf8_validator = { 0 };
+
   while (true)
   {
+    // Skip over the bytes which need no special handling, many at a time, to find the next quote,
+    // backslash, or control character, which might be in a later segment.
+    int32_t const plain_bytes = _az_simd_json_count_plain_string_bytes(
+        token_ptr + current_index, remaining_size - current_index);
+    if (plain_bytes > 0)
+    {
+      // Multi-byte UTF-8 sequences are always within the plain bytes, though they could straddle
+      // segments.
+      if (validate_utf8
+          && !_az_utf8_validate(
+              &utf8_validator, az_span_slice(token, current_index, current_index + plain_bytes)))
+      {
+        return AZ_ERROR_UNEXPECTED_CHAR;
+      }
+
+      current_index += plain_bytes;
+      string_length += plain_bytes;
+
+      if (current_index >= remaining_size)
+      {
+        _az_RETURN_IF_FAILED(_az_json_reader_get_next_buffer(ref_json_reader, &token, false));
+        current_index = 0;
+        token_ptr = az_span_ptr(token);
+        remaining_size = az_span_size(token);
+        next_byte = token_ptr[0];
+        continue;
+      }
+
+      next_byte = token_ptr[current_index];
+    }
+
+    // Any other byte is ASCII, so it can't be within a multi-byte UTF-8 sequence.
+    if (!_az_utf8_validator_is_complete(&utf8_validator))
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
     if (next_byte == '"')
     {
       break;
@@ -421,11 +462,14 @@ AZ_NODISCARD static bool _az_finished_consuming_json_number(
   return false;
 }
 
+// When ref_value isn't NULL, the digits are also accumulated into it, which only gives the right
+// value when there are at most 19 of them.
 static void _az_json_reader_consume_digits(
     az_json_reader* ref_json_reader,
     az_span* token,
     int32_t* current_consumed,
-    int32_t* total_consumed)
+    int32_t* total_consumed,
+    uint64_t* ref_value)
 {
   int32_t counter = 0;
   az_span current = az_span_slice_to_end(*token, *current_consumed);
@@ -438,6 +482,10 @@ static void _az_json_reader_consume_digits(
     {
       if (isdigit(*next_byte_ptr))
       {
+        if (ref_value != NULL)
+        {
+          *ref_value = *ref_value * 10 + (uint64_t)(*next_byte_ptr - '0');
+        }
         counter++;
         next_byte_ptr++;
       }
@@ -500,7 +548,16 @@ AZ_NODISCARD static az_result _az_validate_next_byte_is_digit(
   return AZ_OK;
 }
 
-AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref_json_reader)
+// Reads a number token, and sets the _az_JSON_NUMBER_* flags that describe it, other than
+// _az_JSON_NUMBER_CAPTURED, as well as the number of digits before the exponent, and the power of
+// ten they are scaled by. When ref_magnitude isn't NULL, the digits before the exponent are also
+// accumulated into it, and the value of the exponent is added to ref_exponent.
+AZ_NODISCARD static az_result _az_json_reader_read_number(
+    az_json_reader* ref_json_reader,
+    uint8_t* ref_flags,
+    uint64_t* ref_magnitude,
+    int32_t* ref_digit_count,
+    int32_t* ref_exponent)
 {
   az_span token = _get_remaining_json(ref_json_reader);
 
@@ -510,6 +567,7 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
   uint8_t next_byte = az_span_ptr(token)[0];
   if (next_byte == '-')
   {
+    *ref_flags |= _az_JSON_NUMBER_IS_NEGATIVE;
     total_consumed++;
     current_consumed++;
 
@@ -520,8 +578,13 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
     next_byte = az_span_ptr(token)[current_consumed];
   }
 
+  // Any number that ends before a fraction or an exponent is an integer.
+  *ref_flags |= _az_JSON_NUMBER_IS_INTEGER;
+
   if (next_byte == '0')
   {
+    *ref_flags |= _az_JSON_NUMBER_HAS_MAGNITUDE;
+    *ref_digit_count = 1;
     total_consumed++;
     current_consumed++;
 
@@ -562,7 +625,16 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
     _az_PRECONDITION(isdigit(next_byte));
 
     // Integer part before decimal
-    _az_json_reader_consume_digits(ref_json_reader, &token, &current_consumed, &total_consumed);
+    int32_t const integer_start = total_consumed;
+    _az_json_reader_consume_digits(
+        ref_json_reader, &token, &current_consumed, &total_consumed, ref_magnitude);
+    *ref_digit_count = total_consumed - integer_start;
+
+    // Any number with up to 19 digits fits within a uint64_t.
+    if (*ref_digit_count < _az_MAX_SIZE_FOR_UINT64)
+    {
+      *ref_flags |= _az_JSON_NUMBER_HAS_MAGNITUDE;
+    }
 
     if (current_consumed >= az_span_size(token))
     {
@@ -597,6 +669,8 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
     }
   }
 
+  *ref_flags &= (uint8_t) ~(_az_JSON_NUMBER_IS_INTEGER | _az_JSON_NUMBER_HAS_MAGNITUDE);
+
   if (next_byte == '.')
   {
     total_consumed++;
@@ -606,8 +680,12 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
     _az_RETURN_IF_FAILED(
         _az_validate_next_byte_is_digit(ref_json_reader, &token, &current_consumed));
 
-    // Integer part after decimal
-    _az_json_reader_consume_digits(ref_json_reader, &token, &current_consumed, &total_consumed);
+    // Integer part after decimal, each digit of which scales the number down by ten.
+    int32_t const fraction_start = total_consumed;
+    _az_json_reader_consume_digits(
+        ref_json_reader, &token, &current_consumed, &total_consumed, ref_magnitude);
+    *ref_digit_count += total_consumed - fraction_start;
+    *ref_exponent = fraction_start - total_consumed;
 
     if (current_consumed >= az_span_size(token))
     {
@@ -654,6 +732,7 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
   }
 
   next_byte = az_span_ptr(token)[current_consumed];
+  bool const is_negative_exponent = next_byte == '-';
   if (next_byte == '-' || next_byte == '+')
   {
     total_consumed++;
@@ -665,7 +744,25 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
   }
 
   // Integer part after the 'e'/'E'
-  _az_json_reader_consume_digits(ref_json_reader, &token, &current_consumed, &total_consumed);
+  int32_t const exponent_start = total_consumed;
+  uint64_t exponent = 0;
+  _az_json_reader_consume_digits(
+      ref_json_reader,
+      &token,
+      &current_consumed,
+      &total_consumed,
+      ref_magnitude == NULL ? NULL : &exponent);
+
+  if (ref_magnitude != NULL)
+  {
+    // Any larger exponent is out of the range of a double anyway, and any exponent with up to 19
+    // digits (including leading zeros) fits within a uint64_t.
+    if (total_consumed - exponent_start >= _az_MAX_SIZE_FOR_UINT64 || exponent > INT16_MAX)
+    {
+      exponent = INT16_MAX;
+    }
+    *ref_exponent += is_negative_exponent ? -(int32_t)exponent : (int32_t)exponent;
+  }
 
   if (current_consumed >= az_span_size(token))
   {
@@ -702,6 +799,33 @@ AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref
   return AZ_OK;
 }
 
+AZ_NODISCARD static az_result _az_json_reader_process_number(az_json_reader* ref_json_reader)
+{
+  bool const capture = ref_json_reader->_internal.options.capture_number_values;
+
+  uint8_t flags = 0;
+  uint64_t magnitude = 0;
+  int32_t digit_count = 0;
+  int32_t exponent = 0;
+  _az_RETURN_IF_FAILED(_az_json_reader_read_number(
+      ref_json_reader, &flags, capture ? &magnitude : NULL, &digit_count, &exponent));
+
+  if (!capture)
+  {
+    digit_count = 0;
+    exponent = 0;
+  }
+
+  ref_json_reader->token._internal.number_flags
+      = capture ? (uint8_t)(flags | _az_JSON_NUMBER_CAPTURED) : 0;
+  ref_json_reader->token._internal.number_digit_count
+      = (uint8_t)(digit_count > UINT8_MAX ? UINT8_MAX : digit_count);
+  ref_json_reader->token._internal.number_exponent = (int16_t)(
+      exponent > INT16_MAX ? INT16_MAX : (exponent < INT16_MIN ? INT16_MIN : exponent));
+  ref_json_reader->token._internal.number_magnitude = magnitude;
+  return AZ_OK;
+}
+
 AZ_INLINE int32_t _az_min(int32_t a, int32_t b) { return a < b ? a : b; }
 
 AZ_NODISCARD static az_result _az_json_reader_process_literal(
@@ -949,6 +1073,105 @@ AZ_NODISCARD az_result az_json_reader_next_token(az_json_reader* ref_json_reader
   }
 }
 
+// Moves the reader to the end of the object or array it is currently within, by only tracking the
+// nesting depth and which bytes are within strings, without validating the JSON text in between.
+// The reader must be positioned between tokens, such as right after the start of the object or
+// array.
+AZ_NODISCARD static az_result _az_json_reader_skip_to_container_end(az_json_reader* ref_json_reader)
+{
+  int32_t buffer_index = ref_json_reader->_internal.buffer_index;
+  az_span buffer = ref_json_reader->_internal.json_buffer;
+  int32_t scan_start = ref_json_reader->_internal.bytes_consumed;
+  int32_t total_bytes_consumed = ref_json_reader->_internal.total_bytes_consumed;
+
+  int32_t depth = 1;
+  uint64_t prev_in_string = 0;
+  uint64_t prev_escaped = 0;
+  uint8_t last_block[_az_SIMD_JSON_BLOCK_SIZE];
+
+  while (true)
+  {
+    uint8_t const* const buffer_ptr = az_span_ptr(buffer);
+    int32_t const buffer_size = az_span_size(buffer);
+
+    for (int32_t offset = scan_start; offset < buffer_size; offset += _az_SIMD_JSON_BLOCK_SIZE)
+    {
+      uint8_t const* block = buffer_ptr + offset;
+      int32_t const block_size = buffer_size - offset;
+
+      // Pad the trailing partial block with whitespace, which never affects the nesting.
+      if (block_size < _az_SIMD_JSON_BLOCK_SIZE)
+      {
+        az_span const destination = AZ_SPAN_FROM_BUFFER(last_block);
+        az_span_fill(destination, _az_ASCII_SPACE_CHARACTER);
+        az_span_copy(destination, az_span_slice_to_end(buffer, offset));
+        block = last_block;
+      }
+
+      _az_simd_json_nesting_masks masks;
+      _az_simd_json_classify_nesting_block(block, &masks);
+
+      uint64_t const escaped = _az_simd_json_find_escaped(masks.backslash, &prev_escaped);
+      uint64_t const quotes = masks.quote & ~escaped;
+      uint64_t const in_string = _az_simd_prefix_xor(quotes) ^ prev_in_string;
+      prev_in_string = 0ULL - (in_string >> 63U);
+
+      // A backslash at the end of a buffer segment escapes the first byte of the next one.
+      if (block_size < _az_SIMD_JSON_BLOCK_SIZE)
+      {
+        prev_escaped = (escaped >> (uint32_t)block_size) & 1U;
+      }
+
+      uint64_t const opens = masks.open & ~in_string;
+      uint64_t const closes = masks.close & ~in_string;
+
+      // The depth can only drop to zero within this block if it has enough closing brackets.
+      int32_t const close_count = _az_simd_count_set_bits(closes);
+      if (close_count < depth)
+      {
+        depth += _az_simd_count_set_bits(opens) - close_count;
+        continue;
+      }
+
+      for (uint64_t brackets = opens | closes; brackets != 0; brackets &= brackets - 1)
+      {
+        int32_t const position = _az_simd_count_trailing_zeros(brackets);
+        depth += ((opens >> (uint32_t)position) & 1U) != 0 ? 1 : -1;
+        if (depth == 0)
+        {
+          int32_t const end = offset + position;
+
+          ref_json_reader->_internal.buffer_index = buffer_index;
+          ref_json_reader->_internal.json_buffer = buffer;
+          ref_json_reader->_internal.bytes_consumed = end;
+          ref_json_reader->_internal.total_bytes_consumed
+              = total_bytes_consumed + (end - scan_start);
+
+          ref_json_reader->token._internal.start_buffer_index = -1;
+          ref_json_reader->token._internal.start_buffer_offset = -1;
+          ref_json_reader->token._internal.end_buffer_index = -1;
+          ref_json_reader->token._internal.end_buffer_offset = -1;
+
+          return _az_json_reader_process_container_end(
+              ref_json_reader,
+              buffer_ptr[end] == '}' ? AZ_JSON_TOKEN_END_OBJECT : AZ_JSON_TOKEN_END_ARRAY);
+        }
+      }
+    }
+
+    // Continue within the next buffer segment, if there is one.
+    total_bytes_consumed += buffer_size - scan_start;
+    if (buffer_index >= ref_json_reader->_internal.number_of_buffers - 1)
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    buffer_index++;
+    buffer = ref_json_reader->_internal.json_buffers[buffer_index];
+    scan_start = 0;
+  }
+}
+
 AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_reader)
 {
   _az_PRECONDITION_NOT_NULL(ref_json_reader);
@@ -961,6 +1184,11 @@ AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_rea
   az_json_token_kind const token_kind = ref_json_reader->token.kind;
   if (token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
   {
+    if (ref_json_reader->_internal.options.skip_children_without_validation)
+    {
+      return _az_json_reader_skip_to_container_end(ref_json_reader);
+    }
+
     // Keep moving the reader until we come back to the same depth.
     int32_t const depth = ref_json_reader->_internal.bit_stack._internal.current_depth;
     do
@@ -970,3 +1198,349 @@ AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_rea
   }
   return AZ_OK;
 }
+
+AZ_NODISCARD int32_t _az_json_pointer_segment_end(az_span path, int32_t slash_offset)
+{
+  int32_t const path_size = az_span_size(path);
+  uint8_t const* const path_ptr = az_span_ptr(path);
+
+  int32_t i = slash_offset + 1;
+  while (i < path_size && path_ptr[i] != '/')
+  {
+    i++;
+  }
+  return i;
+}
+
+AZ_NODISCARD int32_t _az_json_pointer_segment_start(az_span path, int32_t slash_offset)
+{
+  uint8_t const* const path_ptr = az_span_ptr(path);
+
+  // Every non-empty path starts with a '/', so this never goes past the start of the path.
+  int32_t i = slash_offset - 1;
+  while (path_ptr[i] != '/')
+  {
+    i--;
+  }
+  return i;
+}
+
+AZ_NODISCARD bool _az_json_token_is_pointer_segment_equal(
+    az_json_token const* json_token,
+    az_span segment)
+{
+  int32_t const segment_size = az_span_size(segment);
+  uint8_t const* const segment_ptr = az_span_ptr(segment);
+
+  int32_t i = 0;
+  while (i < segment_size && segment_ptr[i] != '~')
+  {
+    i++;
+  }
+
+  // Most segments don't contain any escapes, and can be compared as they are.
+  if (i == segment_size)
+  {
+    return az_json_token_is_text_equal(json_token, segment);
+  }
+
+  // The segment is decoded into a buffer on the stack, so a longer one is never matched.
+  if (segment_size > _az_MAX_JSON_POINTER_ESCAPED_SEGMENT_SIZE)
+  {
+    return false;
+  }
+
+  uint8_t decoded[_az_MAX_JSON_POINTER_ESCAPED_SEGMENT_SIZE];
+  int32_t decoded_size = 0;
+  for (i = 0; i < segment_size; i++)
+  {
+    uint8_t next_byte = segment_ptr[i];
+    if (next_byte == '~')
+    {
+      i++;
+      if (i == segment_size || (segment_ptr[i] != '0' && segment_ptr[i] != '1'))
+      {
+        // Invalid JSON pointer escape, which no property name can match.
+        return false;
+      }
+      next_byte = segment_ptr[i] == '0' ? '~' : '/';
+    }
+    decoded[decoded_size] = next_byte;
+    decoded_size++;
+  }
+
+  return az_json_token_is_text_equal(json_token, az_span_create(decoded, decoded_size));
+}
+
+AZ_NODISCARD az_result az_json_reader_find_paths(
+    az_json_reader* ref_json_reader,
+    az_span const paths[],
+    int32_t number_of_paths,
+    az_json_token out_tokens[])
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_reader);
+  _az_PRECONDITION_NOT_NULL(paths);
+  _az_PRECONDITION_RANGE(1, number_of_paths, _az_MAX_JSON_PATHS);
+  _az_PRECONDITION_NOT_NULL(out_tokens);
+
+  az_json_token_kind token_kind = ref_json_reader->token.kind;
+  if (token_kind == AZ_JSON_TOKEN_NONE || token_kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    token_kind = ref_json_reader->token.kind;
+  }
+
+  // For each path, the number of its segments matched by the objects and arrays enclosing the
+  // current position, and the offset of the '/' which starts the next segment to match.
+  // A path can only match the values within the current object or array if the number of segments
+  // it has matched is the same as the depth, relative to the value the paths start from.
+  int32_t matched_segments[_az_MAX_JSON_PATHS];
+  int32_t segment_offsets[_az_MAX_JSON_PATHS];
+  int32_t paths_remaining = number_of_paths;
+
+  // Whether each path was stepped back out of an object or array which it led into without being
+  // found. Only the first occurrence of a property name is matched, and array indices are unique,
+  // so it can't be found anywhere else.
+  bool is_ruled_out[_az_MAX_JSON_PATHS];
+
+  for (int32_t i = 0; i < number_of_paths; i++)
+  {
+    _az_PRECONDITION(az_span_size(paths[i]) == 0 || az_span_ptr(paths[i])[0] == '/');
+
+    matched_segments[i] = 0;
+    segment_offsets[i] = 0;
+    is_ruled_out[i] = false;
+
+    if (az_span_size(paths[i]) == 0)
+    {
+      out_tokens[i] = ref_json_reader->token;
+      paths_remaining--;
+    }
+    else
+    {
+      out_tokens[i] = _az_JSON_TOKEN_DEFAULT;
+    }
+  }
+
+  if (paths_remaining == 0
+      || (token_kind != AZ_JSON_TOKEN_BEGIN_OBJECT && token_kind != AZ_JSON_TOKEN_BEGIN_ARRAY))
+  {
+    return AZ_OK;
+  }
+
+  _az_json_bit_stack const* const bit_stack = &ref_json_reader->_internal.bit_stack;
+  int32_t const root_depth = bit_stack->_internal.current_depth;
+  int32_t depth = 0;
+  int32_t array_index = 0;
+
+  while (true)
+  {
+    bool has_candidates = false;
+    for (int32_t i = 0; i < number_of_paths; i++)
+    {
+      if (matched_segments[i] == depth && out_tokens[i].kind == AZ_JSON_TOKEN_NONE
+          && !is_ruled_out[i])
+      {
+        has_candidates = true;
+        break;
+      }
+    }
+
+    if (has_candidates)
+    {
+      _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    }
+    else
+    {
+      // None of the remaining paths are within the current object or array, skip to its end.
+      if (ref_json_reader->_internal.options.skip_children_without_validation)
+      {
+        _az_RETURN_IF_FAILED(_az_json_reader_skip_to_container_end(ref_json_reader));
+      }
+      else
+      {
+        do
+        {
+          _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+        } while (bit_stack->_internal.current_depth >= root_depth + depth);
+      }
+    }
+
+    token_kind = ref_json_reader->token.kind;
+    if (token_kind == AZ_JSON_TOKEN_END_OBJECT || token_kind == AZ_JSON_TOKEN_END_ARRAY)
+    {
+      if (depth == 0)
+      {
+        return AZ_OK;
+      }
+
+      // Step the paths which led into the object or array that ended back by one segment, so that
+      // they keep track of the position within its parent. Those which weren't found within it
+      // are ruled out.
+      az_span entered_segment = AZ_SPAN_EMPTY;
+      for (int32_t i = 0; i < number_of_paths; i++)
+      {
+        if (matched_segments[i] == depth)
+        {
+          int32_t const segment_end = segment_offsets[i];
+          segment_offsets[i] = _az_json_pointer_segment_start(paths[i], segment_end);
+          matched_segments[i]--;
+          entered_segment = az_span_slice(paths[i], segment_offsets[i] + 1, segment_end);
+
+          if (out_tokens[i].kind == AZ_JSON_TOKEN_NONE && !is_ruled_out[i])
+          {
+            is_ruled_out[i] = true;
+            paths_remaining--;
+          }
+        }
+      }
+      depth--;
+
+      if (paths_remaining == 0)
+      {
+        return AZ_OK;
+      }
+
+      // Within an array, the segment which led into the element that ended is its index.
+      if (_az_json_stack_peek(bit_stack) == _az_JSON_STACK_ARRAY)
+      {
+        _az_RETURN_IF_FAILED(az_span_atoi32(entered_segment, &array_index));
+        array_index++;
+      }
+      continue;
+    }
+
+    az_json_token property_name = _az_JSON_TOKEN_DEFAULT;
+    uint8_t index_buffer[_az_MAX_SIZE_FOR_INT32] = { 0 };
+    az_span index_text = AZ_SPAN_EMPTY;
+
+    if (token_kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+    {
+      property_name = ref_json_reader->token;
+      _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+      token_kind = ref_json_reader->token.kind;
+    }
+    else
+    {
+      az_span remainder = AZ_SPAN_EMPTY;
+      _az_RETURN_IF_FAILED(
+          az_span_i32toa(AZ_SPAN_FROM_BUFFER(index_buffer), array_index, &remainder));
+      index_text = az_span_create(index_buffer, _az_MAX_SIZE_FOR_INT32 - az_span_size(remainder));
+      array_index++;
+    }
+
+    bool const is_container
+        = token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY;
+    bool enter_container = false;
+
+    for (int32_t i = 0; i < number_of_paths; i++)
+    {
+      if (matched_segments[i] != depth || out_tokens[i].kind != AZ_JSON_TOKEN_NONE
+          || is_ruled_out[i])
+      {
+        continue;
+      }
+
+      int32_t const segment_end = _az_json_pointer_segment_end(paths[i], segment_offsets[i]);
+      az_span const segment = az_span_slice(paths[i], segment_offsets[i] + 1, segment_end);
+
+      bool const is_match = property_name.kind == AZ_JSON_TOKEN_PROPERTY_NAME
+          ? _az_json_token_is_pointer_segment_equal(&property_name, segment)
+          : az_span_is_content_equal(segment, index_text);
+
+      if (!is_match)
+      {
+        continue;
+      }
+
+      if (segment_end == az_span_size(paths[i]))
+      {
+        out_tokens[i] = ref_json_reader->token;
+        paths_remaining--;
+      }
+      else if (is_container)
+      {
+        matched_segments[i]++;
+        segment_offsets[i] = segment_end;
+        enter_container = true;
+      }
+      else
+      {
+        // The path continues past a value which has nothing within it.
+        is_ruled_out[i] = true;
+        paths_remaining--;
+      }
+    }
+
+    if (paths_remaining == 0)
+    {
+      return AZ_OK;
+    }
+
+    if (enter_container)
+    {
+      depth++;
+      array_index = 0;
+    }
+    else if (is_container)
+    {
+      _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_json_reader));
+    }
+  }
+}
+
+AZ_NODISCARD az_json_cursor az_json_reader_get_cursor(az_json_reader const* json_reader)
+{
+  _az_PRECONDITION_NOT_NULL(json_reader);
+  // The token is recorded as an offset within the JSON text, which must be a single buffer.
+  _az_PRECONDITION(json_reader->_internal.number_of_buffers == 1);
+
+  az_span const token_slice = json_reader->token.slice;
+
+  // Only the #AZ_JSON_TOKEN_NONE token, before any is read, has no slice within the JSON text. An
+  // empty string still has one, just within its quotes.
+  return (az_json_cursor){
+    ._internal = {
+      .token_offset = az_span_ptr(token_slice) == NULL
+          ? json_reader->_internal.bytes_consumed
+          : (int32_t)(az_span_ptr(token_slice) - az_span_ptr(json_reader->_internal.json_buffer)),
+      .token_size = az_span_size(token_slice),
+      .bytes_consumed = json_reader->_internal.bytes_consumed,
+      .bit_stack = json_reader->_internal.bit_stack,
+      .token_kind = json_reader->token.kind,
+      .string_has_escaped_chars = json_reader->token._internal.string_has_escaped_chars,
+      .is_complex_json = json_reader->_internal.is_complex_json,
+    },
+  };
+}
+
+AZ_NODISCARD az_result az_json_reader_init_at_cursor(
+    az_json_reader* out_json_reader,
+    az_span json_buffer,
+    az_json_cursor const* cursor,
+    az_json_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(cursor);
+  _az_PRECONDITION_RANGE(0, cursor->_internal.bytes_consumed, az_span_size(json_buffer));
+  _az_PRECONDITION_RANGE(0, cursor->_internal.token_offset, cursor->_internal.bytes_consumed);
+  _az_PRECONDITION_RANGE(
+      0,
+      cursor->_internal.token_size,
+      cursor->_internal.bytes_consumed - cursor->_internal.token_offset);
+
+  _az_RETURN_IF_FAILED(az_json_reader_init(out_json_reader, json_buffer, options));
+
+  out_json_reader->token.kind = cursor->_internal.token_kind;
+  int32_t const token_offset = cursor->_internal.token_offset;
+  out_json_reader->token.slice
+      = az_span_slice(json_buffer, token_offset, token_offset + cursor->_internal.token_size);
+  out_json_reader->token.size = cursor->_internal.token_size;
+  out_json_reader->token._internal.string_has_escaped_chars
+      = cursor->_internal.string_has_escaped_chars;
+
+  out_json_reader->_internal.bytes_consumed = cursor->_internal.bytes_consumed;
+  out_json_reader->_internal.total_bytes_consumed = cursor->_internal.bytes_consumed;
+  out_json_reader->_internal.bit_stack = cursor->_internal.bit_stack;
+  out_json_reader->_internal.is_complex_json = cursor->_internal.is_complex_json;
+  return AZ_OK;
+}
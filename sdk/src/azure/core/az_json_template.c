@@ -0,0 +1,316 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+#include <azure/core/internal/az_span_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_json_template_init(
+    az_json_template* out_json_template,
+    az_span template_buffer,
+    az_json_template_slot slots[],
+    int32_t slots_size,
+    az_json_writer_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_template);
+  _az_PRECONDITION(slots_size >= 0);
+  _az_PRECONDITION(slots_size == 0 || slots != NULL);
+
+  *out_json_template = (az_json_template){
+    ._internal = {
+      .slots = slots,
+      .slots_size = slots_size,
+      .number_of_slots = 0,
+    },
+  };
+
+  return az_json_writer_init(&out_json_template->_internal.writer, template_buffer, options);
+}
+
+AZ_NODISCARD az_result az_json_template_append_slot(
+    az_json_template* ref_json_template,
+    az_json_bind_type type,
+    int32_t fractional_digits)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_template);
+  _az_PRECONDITION_RANGE(AZ_JSON_BIND_BOOLEAN, type, AZ_JSON_BIND_STRING);
+  _az_PRECONDITION(
+      type != AZ_JSON_BIND_DOUBLE
+      || (fractional_digits >= AZ_JSON_BIND_DOUBLE_SHORTEST
+          && fractional_digits <= _az_MAX_SUPPORTED_FRACTIONAL_DIGITS));
+
+  if (ref_json_template->_internal.number_of_slots >= ref_json_template->_internal.slots_size)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  // A placeholder value is appended with the writer, so that the template text is valid JSON, and
+  // the writer keeps track of the separators around it.
+  az_json_writer* const writer = &ref_json_template->_internal.writer;
+  switch (type)
+  {
+    case AZ_JSON_BIND_BOOLEAN:
+      _az_RETURN_IF_FAILED(az_json_writer_append_bool(writer, false));
+      break;
+    case AZ_JSON_BIND_STRING:
+      _az_RETURN_IF_FAILED(az_json_writer_append_string(writer, AZ_SPAN_EMPTY));
+      break;
+    default:
+      _az_RETURN_IF_FAILED(az_json_writer_append_int32(writer, 0));
+      break;
+  }
+
+  // The placeholder is always at the end of the text written so far.
+  int32_t const placeholder_size
+      = type == AZ_JSON_BIND_BOOLEAN ? 5 : (type == AZ_JSON_BIND_STRING ? 2 : 1);
+  int32_t const end = az_span_size(az_json_writer_get_bytes_used_in_destination(writer));
+
+  ref_json_template->_internal.slots[ref_json_template->_internal.number_of_slots]
+      = (az_json_template_slot){
+          ._internal = {
+            .start = end - placeholder_size,
+            .end = end,
+            .fractional_digits = fractional_digits,
+            .type = (uint8_t)type,
+          },
+        };
+  ref_json_template->_internal.number_of_slots++;
+
+  return AZ_OK;
+}
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+// The template text is complete JSON once a value has been written, and any objects and arrays it
+// started have been ended.
+AZ_NODISCARD static bool _az_json_template_is_complete(az_json_template const* json_template)
+{
+  az_json_writer const* const writer = &json_template->_internal.writer;
+  return writer->_internal.token_kind != AZ_JSON_TOKEN_NONE
+      && writer->_internal.token_kind != AZ_JSON_TOKEN_PROPERTY_NAME
+      && writer->_internal.bit_stack._internal.current_depth == 0;
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+AZ_NODISCARD az_result az_json_template_writer_init(
+    az_json_template_writer* out_template_writer,
+    az_json_template const* json_template,
+    az_span destination_buffer)
+{
+  _az_PRECONDITION_NOT_NULL(out_template_writer);
+  _az_PRECONDITION_NOT_NULL(json_template);
+  _az_PRECONDITION(_az_json_template_is_complete(json_template));
+
+  *out_template_writer = (az_json_template_writer){
+    ._internal = {
+      .json_template = json_template,
+      .destination_buffer = destination_buffer,
+      .bytes_written = 0,
+      .template_offset = 0,
+      .slot_index = 0,
+    },
+  };
+
+  return AZ_OK;
+}
+
+// Copies the fixed text of the template up to the next slot, and returns the slot, along with the
+// remainder of the destination buffer after the copied text.
+AZ_NODISCARD static az_result _az_json_template_writer_begin_slot(
+    az_json_template_writer* ref_template_writer,
+    az_json_bind_type type,
+    az_json_template_slot const** out_slot,
+    az_span* out_remaining)
+{
+  _az_PRECONDITION_NOT_NULL(ref_template_writer);
+
+  az_json_template const* const json_template = ref_template_writer->_internal.json_template;
+  _az_PRECONDITION(
+      ref_template_writer->_internal.slot_index < json_template->_internal.number_of_slots);
+
+  az_json_template_slot const* const slot
+      = &json_template->_internal.slots[ref_template_writer->_internal.slot_index];
+  _az_PRECONDITION(slot->_internal.type == (uint8_t)type);
+  (void)type;
+
+  az_span const fixed_text = az_span_slice(
+      json_template->_internal.writer._internal.destination_buffer,
+      ref_template_writer->_internal.template_offset,
+      slot->_internal.start);
+
+  az_span remaining = az_span_slice_to_end(
+      ref_template_writer->_internal.destination_buffer,
+      ref_template_writer->_internal.bytes_written);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, az_span_size(fixed_text));
+
+  *out_slot = slot;
+  *out_remaining = az_span_copy(remaining, fixed_text);
+  return AZ_OK;
+}
+
+// Moves past the slot, once its value has been written before the given remainder of the
+// destination buffer.
+static void _az_json_template_writer_end_slot(
+    az_json_template_writer* ref_template_writer,
+    az_json_template_slot const* slot,
+    az_span remaining)
+{
+  ref_template_writer->_internal.bytes_written
+      = _az_span_diff(remaining, ref_template_writer->_internal.destination_buffer);
+  ref_template_writer->_internal.template_offset = slot->_internal.end;
+  ref_template_writer->_internal.slot_index++;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_bool(az_json_template_writer* ref_template_writer, bool value)
+{
+  az_json_template_slot const* slot = NULL;
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_template_writer, AZ_JSON_BIND_BOOLEAN, &slot, &remaining));
+
+  az_span const text = value ? AZ_SPAN_FROM_STR("true") : AZ_SPAN_FROM_STR("false");
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, az_span_size(text));
+
+  _az_json_template_writer_end_slot(ref_template_writer, slot, az_span_copy(remaining, text));
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_int32(az_json_template_writer* ref_template_writer, int32_t value)
+{
+  az_json_template_slot const* slot = NULL;
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_template_writer, AZ_JSON_BIND_INT32, &slot, &remaining));
+
+  _az_RETURN_IF_FAILED(az_span_i32toa(remaining, value, &remaining));
+
+  _az_json_template_writer_end_slot(ref_template_writer, slot, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_uint32(az_json_template_writer* ref_template_writer, uint32_t value)
+{
+  az_json_template_slot const* slot = NULL;
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_template_writer, AZ_JSON_BIND_UINT32, &slot, &remaining));
+
+  _az_RETURN_IF_FAILED(az_span_u32toa(remaining, value, &remaining));
+
+  _az_json_template_writer_end_slot(ref_template_writer, slot, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_int64(az_json_template_writer* ref_template_writer, int64_t value)
+{
+  az_json_template_slot const* slot = NULL;
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_template_writer, AZ_JSON_BIND_INT64, &slot, &remaining));
+
+  _az_RETURN_IF_FAILED(az_span_i64toa(remaining, value, &remaining));
+
+  _az_json_template_writer_end_slot(ref_template_writer, slot, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_double(az_json_template_writer* ref_template_writer, double value)
+{
+  // Non-finite numbers are not supported because they lead to invalid JSON.
+  _az_PRECONDITION(_az_isfinite(value));
+
+  az_json_template_slot const* slot = NULL;
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_template_writer, AZ_JSON_BIND_DOUBLE, &slot, &remaining));
+
+  if (slot->_internal.fractional_digits == AZ_JSON_BIND_DOUBLE_SHORTEST)
+  {
+    _az_RETURN_IF_FAILED(az_span_dtoa_shortest(remaining, value, &remaining));
+  }
+  else
+  {
+    _az_RETURN_IF_FAILED(
+        az_span_dtoa(remaining, value, slot->_internal.fractional_digits, &remaining));
+  }
+
+  _az_json_template_writer_end_slot(ref_template_writer, slot, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_string(az_json_template_writer* ref_template_writer, az_span value)
+{
+  _az_PRECONDITION_VALID_SPAN(value, 0, true);
+  _az_PRECONDITION(az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE);
+
+  az_json_template_slot const* slot = NULL;
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_template_writer, AZ_JSON_BIND_STRING, &slot, &remaining));
+
+  if (ref_template_writer->_internal.json_template->_internal.writer._internal.options.validate_utf8
+      && !_az_span_is_valid_utf8(value))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  int32_t index_of_first_escaped_char = -1;
+  int32_t const required_size
+      = 2 + _az_json_writer_escaped_length(value, &index_of_first_escaped_char, false);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, required_size);
+
+  remaining = az_span_copy_u8(remaining, '"');
+  if (index_of_first_escaped_char == -1)
+  {
+    remaining = az_span_copy(remaining, value);
+  }
+  else
+  {
+    remaining = az_span_copy(remaining, az_span_slice(value, 0, index_of_first_escaped_char));
+    remaining = _az_json_writer_escape_and_copy(
+        remaining, az_span_slice_to_end(value, index_of_first_escaped_char));
+  }
+  remaining = az_span_copy_u8(remaining, '"');
+
+  _az_json_template_writer_end_slot(ref_template_writer, slot, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_get_json(az_json_template_writer* ref_template_writer, az_span* out_json)
+{
+  _az_PRECONDITION_NOT_NULL(ref_template_writer);
+  _az_PRECONDITION_NOT_NULL(out_json);
+
+  az_json_template const* const json_template = ref_template_writer->_internal.json_template;
+  _az_PRECONDITION(
+      ref_template_writer->_internal.slot_index == json_template->_internal.number_of_slots);
+
+  az_span const fixed_text = az_span_slice_to_end(
+      az_json_writer_get_bytes_used_in_destination(&json_template->_internal.writer),
+      ref_template_writer->_internal.template_offset);
+
+  az_span const remaining = az_span_slice_to_end(
+      ref_template_writer->_internal.destination_buffer,
+      ref_template_writer->_internal.bytes_written);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, az_span_size(fixed_text));
+  az_span_copy(remaining, fixed_text);
+
+  ref_template_writer->_internal.bytes_written += az_span_size(fixed_text);
+  *out_json = az_span_slice(
+      ref_template_writer->_internal.destination_buffer,
+      0,
+      ref_template_writer->_internal.bytes_written);
+  return AZ_OK;
+}
@@ -6,6 +6,7 @@
 #include <azure/core/internal/az_span_internal.h>
 
 #include "az_json_private.h"
+#include "az_simd_private.h"
 
 #include "az_span_private.h"
 #include <azure/core/_az_cfg.h>
@@ -83,69 +84,239 @@ AZ_NODISCARD static uint8_t _az_json_unescape_single_byte(uint8_t ch)
   }
 }
 
-AZ_NODISCARD static bool _az_json_token_is_text_equal_helper(
-    az_span token_slice,
-    az_span* expected_text,
-    bool* next_char_escaped)
+// Reads the unescaped text of a JSON string token, one run at a time, across all the buffer
+// segments the token straddles. Each run is either a part of the token which doesn't contain any
+// escapes, returned without being copied, or the UTF-8 encoding of a single escape sequence.
+typedef struct
 {
-  int32_t token_size = az_span_size(token_slice);
-  uint8_t* token_ptr = az_span_ptr(token_slice);
+  az_span const* segments;
+  int32_t segment_index;
+  int32_t end_segment_index;
+  int32_t end_segment_offset;
+  az_span remaining;
+  uint8_t decoded[4];
+} _az_json_unescaper;
+
+AZ_NODISCARD static _az_json_unescaper _az_json_unescaper_create(az_json_token const* json_token)
+{
+  // Contiguous token
+  if (!json_token->_internal.is_multisegment)
+  {
+    return (_az_json_unescaper){
+      .segments = &json_token->slice,
+      .segment_index = 0,
+      .end_segment_index = 0,
+      .end_segment_offset = az_span_size(json_token->slice),
+      .remaining = json_token->slice,
+      .decoded = { 0 },
+    };
+  }
 
-  int32_t expected_size = az_span_size(*expected_text);
-  uint8_t* expected_ptr = az_span_ptr(*expected_text);
+  // Token straddles more than one segment
+  az_span const* const segments = json_token->_internal.pointer_to_first_buffer;
+  int32_t const start_index = json_token->_internal.start_buffer_index;
+  return (_az_json_unescaper){
+    .segments = segments,
+    .segment_index = start_index,
+    .end_segment_index = json_token->_internal.end_buffer_index,
+    .end_segment_offset = json_token->_internal.end_buffer_offset,
+    .remaining
+    = az_span_slice_to_end(segments[start_index], json_token->_internal.start_buffer_offset),
+    .decoded = { 0 },
+  };
+}
 
-  int32_t token_idx = 0;
-  for (int32_t i = 0; i < expected_size; i++)
+// Moves past any empty segments, returning false if there are no bytes left to read.
+AZ_NODISCARD static bool _az_json_unescaper_has_bytes(_az_json_unescaper* ref_unescaper)
+{
+  while (az_span_size(ref_unescaper->remaining) == 0)
   {
-    if (token_idx >= token_size)
+    if (ref_unescaper->segment_index >= ref_unescaper->end_segment_index)
     {
-      *expected_text = az_span_slice_to_end(*expected_text, i);
       return false;
     }
-    uint8_t token_byte = token_ptr[token_idx];
 
-    if (token_byte == '\\' || *next_char_escaped)
+    ref_unescaper->segment_index++;
+    ref_unescaper->remaining = ref_unescaper->segments[ref_unescaper->segment_index];
+    if (ref_unescaper->segment_index == ref_unescaper->end_segment_index)
     {
-      if (*next_char_escaped)
-      {
-        token_byte = _az_json_unescape_single_byte(token_byte);
-      }
-      else
-      {
-        token_idx++;
-        if (token_idx >= token_size)
-        {
-          *next_char_escaped = true;
-          *expected_text = az_span_slice_to_end(*expected_text, i);
-          return false;
-        }
-        token_byte = _az_json_unescape_single_byte(token_ptr[token_idx]);
-      }
-      *next_char_escaped = false;
+      ref_unescaper->remaining
+          = az_span_slice(ref_unescaper->remaining, 0, ref_unescaper->end_segment_offset);
+    }
+  }
+  return true;
+}
+
+AZ_NODISCARD static bool _az_json_unescaper_read_byte(
+    _az_json_unescaper* ref_unescaper,
+    uint8_t* out_byte)
+{
+  if (!_az_json_unescaper_has_bytes(ref_unescaper))
+  {
+    return false;
+  }
 
-      // TODO: Characters escaped in the form of \uXXXX where XXXX is the UTF-16 code point, is
-      // not currently supported.
-      // To do this, we need to encode UTF-16 codepoints (including surrogate pairs) into UTF-8.
-      if (token_byte == 'u')
+  *out_byte = az_span_ptr(ref_unescaper->remaining)[0];
+  ref_unescaper->remaining = az_span_slice_to_end(ref_unescaper->remaining, 1);
+  return true;
+}
+
+// Reads the 4 hex digits of a UTF-16 code unit, following a \u.
+AZ_NODISCARD static bool _az_json_unescaper_read_code_unit(
+    _az_json_unescaper* ref_unescaper,
+    uint32_t* out_code_unit)
+{
+  uint32_t code_unit = 0;
+  for (int32_t i = 0; i < 4; i++)
+  {
+    uint8_t digit = 0;
+    if (!_az_json_unescaper_read_byte(ref_unescaper, &digit))
+    {
+      return false;
+    }
+
+    if (digit >= '0' && digit <= '9')
+    {
+      digit = (uint8_t)(digit - '0');
+    }
+    else
+    {
+      // Fold upper case hex digits to lower case.
+      digit = (uint8_t)(digit | 0x20);
+      if (digit < 'a' || digit > 'f')
       {
-        *expected_text = AZ_SPAN_EMPTY;
         return false;
       }
+      digit = (uint8_t)(digit - 'a' + 10);
     }
 
-    if (token_byte != expected_ptr[i])
+    code_unit = (code_unit << 4U) | digit;
+  }
+
+  *out_code_unit = code_unit;
+  return true;
+}
+
+// Writes the UTF-8 encoding of a Unicode code point, returning the number of bytes written.
+AZ_NODISCARD static int32_t _az_json_encode_utf8(uint32_t code_point, uint8_t destination[4])
+{
+  if (code_point < 0x80)
+  {
+    destination[0] = (uint8_t)code_point;
+    return 1;
+  }
+
+  if (code_point < 0x800)
+  {
+    destination[0] = (uint8_t)(0xC0 | (code_point >> 6U));
+    destination[1] = (uint8_t)(0x80 | (code_point & 0x3F));
+    return 2;
+  }
+
+  if (code_point < 0x10000)
+  {
+    destination[0] = (uint8_t)(0xE0 | (code_point >> 12U));
+    destination[1] = (uint8_t)(0x80 | ((code_point >> 6U) & 0x3F));
+    destination[2] = (uint8_t)(0x80 | (code_point & 0x3F));
+    return 3;
+  }
+
+  destination[0] = (uint8_t)(0xF0 | (code_point >> 18U));
+  destination[1] = (uint8_t)(0x80 | ((code_point >> 12U) & 0x3F));
+  destination[2] = (uint8_t)(0x80 | ((code_point >> 6U) & 0x3F));
+  destination[3] = (uint8_t)(0x80 | (code_point & 0x3F));
+  return 4;
+}
+
+// Decodes the \uXXXX escape the unescaper is positioned after the 'u' of, along with the low
+// surrogate that follows it, if it is a high surrogate.
+AZ_NODISCARD static bool _az_json_unescaper_decode_unicode(
+    _az_json_unescaper* ref_unescaper,
+    az_span* out_run)
+{
+  uint32_t code_point = 0;
+  if (!_az_json_unescaper_read_code_unit(ref_unescaper, &code_point))
+  {
+    return false;
+  }
+
+  if (code_point >= _az_UTF16_HIGH_SURROGATE_START && code_point < _az_UTF16_LOW_SURROGATE_START)
+  {
+    // Characters outside of the basic multilingual plane are escaped as a surrogate pair.
+    _az_json_unescaper const after_high_surrogate = *ref_unescaper;
+
+    uint8_t backslash = 0;
+    uint8_t u = 0;
+    uint32_t low_surrogate = 0;
+    if (_az_json_unescaper_read_byte(ref_unescaper, &backslash) && backslash == '\\'
+        && _az_json_unescaper_read_byte(ref_unescaper, &u) && u == 'u'
+        && _az_json_unescaper_read_code_unit(ref_unescaper, &low_surrogate)
+        && low_surrogate >= _az_UTF16_LOW_SURROGATE_START
+        && low_surrogate <= _az_UTF16_LOW_SURROGATE_END)
     {
-      *expected_text = AZ_SPAN_EMPTY;
-      return false;
+      code_point = _az_UTF16_SUPPLEMENTARY_PLANE_START
+          + ((code_point - _az_UTF16_HIGH_SURROGATE_START) << 10U)
+          + (low_surrogate - _az_UTF16_LOW_SURROGATE_START);
     }
+    else
+    {
+      // A high surrogate that isn't followed by a low surrogate can't be represented in UTF-8.
+      *ref_unescaper = after_high_surrogate;
+      code_point = _az_UNICODE_REPLACEMENT_CHARACTER;
+    }
+  }
+  else if (
+      code_point >= _az_UTF16_LOW_SURROGATE_START && code_point <= _az_UTF16_LOW_SURROGATE_END)
+  {
+    // Neither can a low surrogate on its own.
+    code_point = _az_UNICODE_REPLACEMENT_CHARACTER;
+  }
+
+  int32_t const encoded_size = _az_json_encode_utf8(code_point, ref_unescaper->decoded);
+  *out_run = az_span_create(ref_unescaper->decoded, encoded_size);
+  return true;
+}
 
-    token_idx++;
+// Gets the next run of unescaped text, returning false once the whole token has been read.
+AZ_NODISCARD static bool
+_az_json_unescaper_next(_az_json_unescaper* ref_unescaper, az_span* out_run)
+{
+  if (!_az_json_unescaper_has_bytes(ref_unescaper))
+  {
+    return false;
+  }
+
+  az_span const remaining = ref_unescaper->remaining;
+  uint8_t const* const remaining_ptr = az_span_ptr(remaining);
+
+  // Return everything up to the next escape without copying it.
+  if (remaining_ptr[0] != '\\')
+  {
+    int32_t const run_size
+        = _az_simd_count_bytes_before(remaining_ptr, az_span_size(remaining), '\\');
+    *out_run = az_span_slice(remaining, 0, run_size);
+    ref_unescaper->remaining = az_span_slice_to_end(remaining, run_size);
+    return true;
   }
 
-  *expected_text = AZ_SPAN_EMPTY;
+  ref_unescaper->remaining = az_span_slice_to_end(remaining, 1);
 
-  // Only return true if the size of the unescaped token matches the expected size exactly.
-  return token_idx == token_size;
+  // The JSON string token has already been validated by the reader, so the escape sequence is
+  // complete, though it could straddle segments.
+  uint8_t escaped_byte = 0;
+  if (!_az_json_unescaper_read_byte(ref_unescaper, &escaped_byte))
+  {
+    return false;
+  }
+
+  if (escaped_byte == 'u')
+  {
+    return _az_json_unescaper_decode_unicode(ref_unescaper, out_run);
+  }
+
+  ref_unescaper->decoded[0] = _az_json_unescape_single_byte(escaped_byte);
+  *out_run = az_span_create(ref_unescaper->decoded, 1);
+  return true;
 }
 
 AZ_NODISCARD bool az_json_token_is_text_equal(
@@ -209,38 +380,60 @@ AZ_NODISCARD bool az_json_token_is_text_equal(
     return false;
   }
 
-  bool next_char_escaped = false;
-
-  // Contiguous token
-  if (!json_token->_internal.is_multisegment)
+  // Compare each run of unescaped text in turn, so that the token is only read once.
+  _az_json_unescaper unescaper = _az_json_unescaper_create(json_token);
+  az_span run = AZ_SPAN_EMPTY;
+  while (_az_json_unescaper_next(&unescaper, &run))
   {
-    return _az_json_token_is_text_equal_helper(token_slice, &expected_text, &next_char_escaped);
-  }
-
-  // Token straddles more than one segment
-  for (int32_t i = json_token->_internal.start_buffer_index;
-       i <= json_token->_internal.end_buffer_index;
-       i++)
-  {
-    az_span source = json_token->_internal.pointer_to_first_buffer[i];
-    if (i == json_token->_internal.start_buffer_index)
+    int32_t const run_size = az_span_size(run);
+    if (az_span_size(expected_text) < run_size
+        || !az_span_is_content_equal(run, az_span_slice(expected_text, 0, run_size)))
     {
-      source = az_span_slice_to_end(source, json_token->_internal.start_buffer_offset);
+      return false;
     }
-    else if (i == json_token->_internal.end_buffer_index)
+    expected_text = az_span_slice_to_end(expected_text, run_size);
+  }
+
+  // Only return true if we have gone through and compared the entire expected_text.
+  return az_span_size(expected_text) == 0;
+}
+
+AZ_NODISCARD bool _az_json_token_is_unescaped_text_equal(
+    az_json_token const* first_token,
+    az_json_token const* second_token)
+{
+  _az_PRECONDITION_NOT_NULL(first_token);
+  _az_PRECONDITION_NOT_NULL(second_token);
+
+  // Unescape both tokens a run at a time, comparing as much of the current runs as they share, so
+  // that neither of them needs to be copied.
+  _az_json_unescaper first_unescaper = _az_json_unescaper_create(first_token);
+  _az_json_unescaper second_unescaper = _az_json_unescaper_create(second_token);
+  az_span first_run = AZ_SPAN_EMPTY;
+  az_span second_run = AZ_SPAN_EMPTY;
+
+  while (true)
+  {
+    bool const first_has_text = az_span_size(first_run) > 0
+        || _az_json_unescaper_next(&first_unescaper, &first_run);
+    bool const second_has_text = az_span_size(second_run) > 0
+        || _az_json_unescaper_next(&second_unescaper, &second_run);
+    if (!first_has_text || !second_has_text)
     {
-      source = az_span_slice(source, 0, json_token->_internal.end_buffer_offset);
+      return first_has_text == second_has_text;
     }
 
-    if (!_az_json_token_is_text_equal_helper(source, &expected_text, &next_char_escaped)
-        && az_span_size(expected_text) == 0)
+    int32_t const first_size = az_span_size(first_run);
+    int32_t const second_size = az_span_size(second_run);
+    int32_t const shared_size = first_size < second_size ? first_size : second_size;
+    if (!az_span_is_content_equal(
+            az_span_slice(first_run, 0, shared_size), az_span_slice(second_run, 0, shared_size)))
     {
       return false;
     }
+    first_run = az_span_slice_to_end(first_run, shared_size);
+    second_run = az_span_slice_to_end(second_run, shared_size);
   }
-
-  // Only return true if we have gone through and compared the entire expected_text.
-  return az_span_size(expected_text) == 0;
 }
 
 AZ_NODISCARD az_result az_json_token_get_boolean(az_json_token const* json_token, bool* out_value)
@@ -274,57 +467,6 @@ AZ_NODISCARD az_result az_json_token_get_boolean(az_json_token const* json_token
   return AZ_OK;
 }
 
-AZ_NODISCARD static az_result _az_json_token_get_string_helper(
-    az_span source,
-    char* destination,
-    int32_t destination_max_size,
-    int32_t* dest_idx,
-    bool* next_char_escaped)
-{
-  int32_t source_size = az_span_size(source);
-  uint8_t* source_ptr = az_span_ptr(source);
-  for (int32_t i = 0; i < source_size; i++)
-  {
-    if (*dest_idx >= destination_max_size)
-    {
-      return AZ_ERROR_NOT_ENOUGH_SPACE;
-    }
-    uint8_t token_byte = source_ptr[i];
-
-    if (token_byte == '\\' || *next_char_escaped)
-    {
-      if (*next_char_escaped)
-      {
-        token_byte = _az_json_unescape_single_byte(token_byte);
-      }
-      else
-      {
-        i++;
-        if (i >= source_size)
-        {
-          *next_char_escaped = true;
-          break;
-        }
-        token_byte = _az_json_unescape_single_byte(source_ptr[i]);
-      }
-      *next_char_escaped = false;
-
-      // TODO: Characters escaped in the form of \uXXXX where XXXX is the UTF-16 code point, is
-      // not currently supported.
-      // To do this, we need to encode UTF-16 codepoints (including surrogate pairs) into UTF-8.
-      if (token_byte == 'u')
-      {
-        return AZ_ERROR_NOT_IMPLEMENTED;
-      }
-    }
-
-    destination[*dest_idx] = (char)token_byte;
-    *dest_idx = *dest_idx + 1;
-  }
-
-  return AZ_OK;
-}
-
 AZ_NODISCARD az_result az_json_token_get_string(
     az_json_token const* json_token,
     char* destination,
@@ -383,49 +525,78 @@ AZ_NODISCARD az_result az_json_token_get_string(
     return AZ_ERROR_NOT_ENOUGH_SPACE;
   }
 
-  int32_t dest_idx = 0;
-  bool next_char_escaped = false;
+  // Copy each run of unescaped text in turn, so that the token is only read once.
+  az_span remainder = az_span_create((uint8_t*)destination, destination_max_size);
+  _az_json_unescaper unescaper = _az_json_unescaper_create(json_token);
+  az_span run = AZ_SPAN_EMPTY;
+  while (_az_json_unescaper_next(&unescaper, &run))
+  {
+    // We also need enough space to add a null terminator.
+    if (az_span_size(run) >= az_span_size(remainder))
+    {
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+    remainder = az_span_copy(remainder, run);
+  }
 
-  // Contiguous token
-  if (!json_token->_internal.is_multisegment)
+  // Add a null terminator.
+  az_span_copy_u8(remainder, 0);
+
+  if (out_string_length != NULL)
   {
-    _az_RETURN_IF_FAILED(_az_json_token_get_string_helper(
-        token_slice, destination, destination_max_size, &dest_idx, &next_char_escaped));
+    *out_string_length = destination_max_size - az_span_size(remainder);
   }
-  else
+
+  return AZ_OK;
+}
+
+// Gets the absolute value of an integer from what the reader captured about the number token,
+// giving the same result as parsing its JSON text would. Returns false if the number wasn't
+// captured, or has too many digits, so its JSON text still needs to be parsed.
+AZ_NODISCARD static bool _az_json_token_get_captured_integer(
+    az_json_token const* json_token,
+    uint64_t max_value,
+    bool allow_negative,
+    uint64_t* out_magnitude,
+    az_result* out_result)
+{
+  uint8_t const flags = json_token->_internal.number_flags;
+  if ((flags & _az_JSON_NUMBER_CAPTURED) == 0)
   {
-    // Token straddles more than one segment
-    for (int32_t i = json_token->_internal.start_buffer_index;
-         i <= json_token->_internal.end_buffer_index;
-         i++)
-    {
-      az_span source = json_token->_internal.pointer_to_first_buffer[i];
-      if (i == json_token->_internal.start_buffer_index)
-      {
-        source = az_span_slice_to_end(source, json_token->_internal.start_buffer_offset);
-      }
-      else if (i == json_token->_internal.end_buffer_index)
-      {
-        source = az_span_slice(source, 0, json_token->_internal.end_buffer_offset);
-      }
+    return false;
+  }
 
-      _az_RETURN_IF_FAILED(_az_json_token_get_string_helper(
-          source, destination, destination_max_size, &dest_idx, &next_char_escaped));
-    }
+  *out_result = AZ_ERROR_UNEXPECTED_CHAR;
+
+  // Fractions and exponents aren't allowed.
+  if ((flags & _az_JSON_NUMBER_IS_INTEGER) == 0)
+  {
+    return true;
   }
 
-  if (dest_idx >= destination_max_size)
+  if ((flags & _az_JSON_NUMBER_IS_NEGATIVE) != 0)
   {
-    return AZ_ERROR_NOT_ENOUGH_SPACE;
+    if (!allow_negative)
+    {
+      return true;
+    }
+
+    // The absolute value of INT64_MIN (or INT32_MIN) is 1 more than the absolute value of
+    // INT64_MAX (or INT32_MAX).
+    max_value++;
   }
-  destination[dest_idx] = 0;
 
-  if (out_string_length != NULL)
+  if ((flags & _az_JSON_NUMBER_HAS_MAGNITUDE) == 0)
   {
-    *out_string_length = dest_idx;
+    return false;
   }
 
-  return AZ_OK;
+  if (json_token->_internal.number_magnitude <= max_value)
+  {
+    *out_magnitude = json_token->_internal.number_magnitude;
+    *out_result = AZ_OK;
+  }
+  return true;
 }
 
 AZ_NODISCARD az_result
@@ -439,6 +610,14 @@ az_json_token_get_uint64(az_json_token const* json_token, uint64_t* out_value)
     return AZ_ERROR_JSON_INVALID_STATE;
   }
 
+  uint64_t magnitude = 0;
+  az_result result = AZ_OK;
+  if (_az_json_token_get_captured_integer(json_token, UINT64_MAX, false, &magnitude, &result))
+  {
+    *out_value = magnitude;
+    return result;
+  }
+
   az_span token_slice = json_token->slice;
 
   // Contiguous token
@@ -474,6 +653,14 @@ az_json_token_get_uint32(az_json_token const* json_token, uint32_t* out_value)
     return AZ_ERROR_JSON_INVALID_STATE;
   }
 
+  uint64_t magnitude = 0;
+  az_result result = AZ_OK;
+  if (_az_json_token_get_captured_integer(json_token, UINT32_MAX, false, &magnitude, &result))
+  {
+    *out_value = (uint32_t)magnitude;
+    return result;
+  }
+
   az_span token_slice = json_token->slice;
 
   // Contiguous token
@@ -508,6 +695,17 @@ AZ_NODISCARD az_result az_json_token_get_int64(az_json_token const* json_token,
     return AZ_ERROR_JSON_INVALID_STATE;
   }
 
+  uint64_t magnitude = 0;
+  az_result result = AZ_OK;
+  if (_az_json_token_get_captured_integer(json_token, INT64_MAX, true, &magnitude, &result))
+  {
+    // Negating magnitude - 1 avoids overflowing when the number is INT64_MIN.
+    *out_value = (json_token->_internal.number_flags & _az_JSON_NUMBER_IS_NEGATIVE) != 0
+        ? -(int64_t)(magnitude - 1) - 1
+        : (int64_t)magnitude;
+    return result;
+  }
+
   az_span token_slice = json_token->slice;
 
   // Contiguous token
@@ -542,6 +740,17 @@ AZ_NODISCARD az_result az_json_token_get_int32(az_json_token const* json_token,
     return AZ_ERROR_JSON_INVALID_STATE;
   }
 
+  uint64_t magnitude = 0;
+  az_result result = AZ_OK;
+  if (_az_json_token_get_captured_integer(json_token, INT32_MAX, true, &magnitude, &result))
+  {
+    // Negating magnitude - 1 avoids overflowing when the number is INT32_MIN.
+    *out_value = (json_token->_internal.number_flags & _az_JSON_NUMBER_IS_NEGATIVE) != 0
+        ? -(int32_t)(magnitude - 1) - 1
+        : (int32_t)magnitude;
+    return result;
+  }
+
   az_span token_slice = json_token->slice;
 
   // Contiguous token
@@ -576,26 +785,48 @@ AZ_NODISCARD az_result az_json_token_get_double(az_json_token const* json_token,
     return AZ_ERROR_JSON_INVALID_STATE;
   }
 
-  az_span token_slice = json_token->slice;
-
-  // Contiguous token
-  if (!json_token->_internal.is_multisegment)
+  // Any number longer than this is not supported.
+  if (json_token->size > _az_MAX_SIZE_FOR_PARSING_DOUBLE)
   {
-    return az_span_atod(token_slice, out_value);
+    return AZ_ERROR_UNEXPECTED_CHAR;
   }
 
-  // Any number that won't fit in the scratch buffer, will overflow.
-  if (json_token->size > _az_MAX_SIZE_FOR_PARSING_DOUBLE)
+  // Integers up to _az_MAX_SAFE_INTEGER are exactly representable as a double, so converting the
+  // captured value gives the same result as parsing the JSON text.
+  uint8_t const flags = json_token->_internal.number_flags;
+  if ((flags & _az_JSON_NUMBER_CAPTURED) != 0 && (flags & _az_JSON_NUMBER_HAS_MAGNITUDE) != 0
+      && json_token->_internal.number_magnitude <= _az_MAX_SAFE_INTEGER)
   {
-    return AZ_ERROR_UNEXPECTED_CHAR;
+    double const value = (double)json_token->_internal.number_magnitude;
+    *out_value = (flags & _az_JSON_NUMBER_IS_NEGATIVE) != 0 ? -value : value;
+    return AZ_OK;
   }
 
-  // Token straddles more than one segment.
-  // Used to copy discontiguous token values into a contiguous buffer, for number parsing.
-  uint8_t scratch_buffer[_az_MAX_SIZE_FOR_PARSING_DOUBLE] = { 0 };
-  az_span scratch = AZ_SPAN_FROM_BUFFER(scratch_buffer);
+  // Other numbers with few enough digits, and a small enough exponent, are converted exactly from
+  // the digits captured while reading them, without scanning the JSON text again.
+  double value = 0;
+  if ((flags & _az_JSON_NUMBER_CAPTURED) != 0
+      && json_token->_internal.number_digit_count < _az_MAX_SIZE_FOR_UINT64
+      && _az_span_exact_decimal_to_double(
+          json_token->_internal.number_magnitude, json_token->_internal.number_exponent, &value))
+  {
+    *out_value = (flags & _az_JSON_NUMBER_IS_NEGATIVE) != 0 ? -value : value;
+    return AZ_OK;
+  }
 
-  az_span remainder = _az_json_token_copy_into_span_helper(json_token, scratch);
+  // Contiguous token
+  if (!json_token->_internal.is_multisegment)
+  {
+    return az_span_atod(json_token->slice, out_value);
+  }
 
-  return az_span_atod(az_span_slice(scratch, 0, _az_span_diff(remainder, scratch)), out_value);
+  // Token straddles more than one segment, so parse it directly from each of the segments.
+  return _az_span_segments_atod(
+      _az_span_segments_create(
+          json_token->_internal.pointer_to_first_buffer,
+          json_token->_internal.start_buffer_index,
+          json_token->_internal.start_buffer_offset,
+          json_token->_internal.end_buffer_index,
+          json_token->_internal.end_buffer_offset),
+      out_value);
 }
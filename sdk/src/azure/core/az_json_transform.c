@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+#include <azure/core/internal/az_span_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD static az_result _az_json_transform_append_container_start(
+    az_json_writer* ref_json_writer,
+    az_json_token_kind token_kind)
+{
+  return token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+      ? az_json_writer_append_begin_object(ref_json_writer)
+      : az_json_writer_append_begin_array(ref_json_writer);
+}
+
+AZ_NODISCARD az_result az_json_transform(
+    az_json_reader* ref_json_reader,
+    az_json_writer* ref_json_writer,
+    az_json_transform_rule const rules[],
+    int32_t number_of_rules)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_reader);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(number_of_rules == 0 || rules != NULL);
+  _az_PRECONDITION_RANGE(0, number_of_rules, _az_MAX_JSON_PATHS);
+  // Values are copied as is from the text read, which must all be within a single buffer.
+  _az_PRECONDITION(ref_json_reader->_internal.number_of_buffers == 1);
+
+  az_json_token_kind token_kind = ref_json_reader->token.kind;
+  if (token_kind == AZ_JSON_TOKEN_NONE || token_kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    token_kind = ref_json_reader->token.kind;
+  }
+
+  if (number_of_rules == 0
+      || (token_kind != AZ_JSON_TOKEN_BEGIN_OBJECT && token_kind != AZ_JSON_TOKEN_BEGIN_ARRAY))
+  {
+    return _az_json_writer_append_reader_value(ref_json_writer, ref_json_reader);
+  }
+
+  // For each rule, the number of its path segments matched by the objects and arrays enclosing the
+  // current position, and the offset of the '/' which starts the next segment to match, in the
+  // same way as within az_json_reader_find_paths().
+  int32_t matched_segments[_az_MAX_JSON_PATHS];
+  int32_t segment_offsets[_az_MAX_JSON_PATHS];
+
+  for (int32_t i = 0; i < number_of_rules; i++)
+  {
+    _az_PRECONDITION(az_span_size(rules[i].path) > 0 && az_span_ptr(rules[i].path)[0] == '/');
+    _az_PRECONDITION(
+        rules[i].action == AZ_JSON_TRANSFORM_DROP || rules[i].action == AZ_JSON_TRANSFORM_RENAME
+        || rules[i].action == AZ_JSON_TRANSFORM_KEEP);
+
+    matched_segments[i] = 0;
+    segment_offsets[i] = 0;
+  }
+
+  _az_RETURN_IF_FAILED(_az_json_transform_append_container_start(ref_json_writer, token_kind));
+
+  _az_json_bit_stack const* const bit_stack = &ref_json_reader->_internal.bit_stack;
+  int32_t depth = 0;
+  int32_t array_index = 0;
+
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    token_kind = ref_json_reader->token.kind;
+
+    if (token_kind == AZ_JSON_TOKEN_END_OBJECT || token_kind == AZ_JSON_TOKEN_END_ARRAY)
+    {
+      _az_RETURN_IF_FAILED(
+          token_kind == AZ_JSON_TOKEN_END_OBJECT
+              ? az_json_writer_append_end_object(ref_json_writer)
+              : az_json_writer_append_end_array(ref_json_writer));
+      if (depth == 0)
+      {
+        return AZ_OK;
+      }
+
+      // Step the rules which led into the object or array that ended back by one segment.
+      az_span entered_segment = AZ_SPAN_EMPTY;
+      for (int32_t i = 0; i < number_of_rules; i++)
+      {
+        if (matched_segments[i] == depth)
+        {
+          int32_t const segment_end = segment_offsets[i];
+          segment_offsets[i] = _az_json_pointer_segment_start(rules[i].path, segment_end);
+          matched_segments[i]--;
+          entered_segment = az_span_slice(rules[i].path, segment_offsets[i] + 1, segment_end);
+        }
+      }
+      depth--;
+
+      // Within an array, the segment which led into the element that ended is its index.
+      if (_az_json_stack_peek(bit_stack) == _az_JSON_STACK_ARRAY)
+      {
+        _az_RETURN_IF_FAILED(az_span_atoi32(entered_segment, &array_index));
+        array_index++;
+      }
+      continue;
+    }
+
+    az_json_token property_name = _az_JSON_TOKEN_DEFAULT;
+    uint8_t index_buffer[_az_MAX_SIZE_FOR_INT32] = { 0 };
+    az_span index_text = AZ_SPAN_EMPTY;
+
+    if (token_kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+    {
+      property_name = ref_json_reader->token;
+      _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+      token_kind = ref_json_reader->token.kind;
+    }
+    else
+    {
+      az_span remainder = AZ_SPAN_EMPTY;
+      _az_RETURN_IF_FAILED(
+          az_span_i32toa(AZ_SPAN_FROM_BUFFER(index_buffer), array_index, &remainder));
+      index_text = az_span_create(index_buffer, _az_MAX_SIZE_FOR_INT32 - az_span_size(remainder));
+      array_index++;
+    }
+
+    bool const is_container
+        = token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY;
+
+    // Find the rule which refers to this property or array element, and the rules which refer to a
+    // value within it. Within an object or array that a rule keeping a value goes through, the
+    // values no rule refers to are left out.
+    az_json_transform_rule const* applied_rule = NULL;
+    int32_t entered_segment_ends[_az_MAX_JSON_PATHS];
+    bool enter_container = false;
+    bool is_projected = false;
+
+    for (int32_t i = 0; i < number_of_rules; i++)
+    {
+      entered_segment_ends[i] = -1;
+      if (matched_segments[i] != depth)
+      {
+        continue;
+      }
+
+      is_projected = is_projected || rules[i].action == AZ_JSON_TRANSFORM_KEEP;
+
+      int32_t const segment_end = _az_json_pointer_segment_end(rules[i].path, segment_offsets[i]);
+      az_span const segment = az_span_slice(rules[i].path, segment_offsets[i] + 1, segment_end);
+
+      bool const is_match = property_name.kind == AZ_JSON_TOKEN_PROPERTY_NAME
+          ? _az_json_token_is_pointer_segment_equal(&property_name, segment)
+          : az_span_is_content_equal(segment, index_text);
+
+      if (!is_match)
+      {
+        continue;
+      }
+
+      if (segment_end == az_span_size(rules[i].path))
+      {
+        if (applied_rule == NULL)
+        {
+          applied_rule = &rules[i];
+        }
+      }
+      else if (is_container)
+      {
+        entered_segment_ends[i] = segment_end;
+        enter_container = true;
+      }
+    }
+
+    if ((applied_rule != NULL && applied_rule->action == AZ_JSON_TRANSFORM_DROP)
+        || (applied_rule == NULL && !enter_container && is_projected))
+    {
+      _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_json_reader));
+      continue;
+    }
+
+    if (property_name.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+    {
+      _az_RETURN_IF_FAILED(
+          applied_rule != NULL && applied_rule->action == AZ_JSON_TRANSFORM_RENAME
+              ? az_json_writer_append_property_name(ref_json_writer, applied_rule->new_name)
+              : _az_json_writer_append_raw_property_name(ref_json_writer, property_name.slice));
+    }
+
+    if (!enter_container)
+    {
+      _az_RETURN_IF_FAILED(_az_json_writer_append_reader_value(ref_json_writer, ref_json_reader));
+      continue;
+    }
+
+    // Some rules refer to values within this object or array, so it is read a token at a time.
+    _az_RETURN_IF_FAILED(_az_json_transform_append_container_start(ref_json_writer, token_kind));
+    for (int32_t i = 0; i < number_of_rules; i++)
+    {
+      if (entered_segment_ends[i] != -1)
+      {
+        segment_offsets[i] = entered_segment_ends[i];
+        matched_segments[i]++;
+      }
+    }
+    depth++;
+    array_index = 0;
+  }
+}
@@ -3,6 +3,7 @@
 
 #include "az_hex_private.h"
 #include "az_json_private.h"
+#include "az_simd_private.h"
 #include "az_span_private.h"
 #include <azure/core/az_json.h>
 #include <azure/core/internal/az_result_internal.h>
@@ -24,6 +25,7 @@ AZ_NODISCARD az_result az_json_writer_init(
       .destination_buffer = destination_buffer,
       .allocator_callback = NULL,
       .user_context = NULL,
+      .is_sizing = false,
       .bytes_written = 0,
       .total_bytes_written = 0,
       .need_comma = false,
@@ -50,6 +52,7 @@ AZ_NODISCARD az_result az_json_writer_chunked_init(
       .destination_buffer = first_destination_buffer,
       .allocator_callback = allocator_callback,
       .user_context = user_context,
+      .is_sizing = false,
       .bytes_written = 0,
       .total_bytes_written = 0,
       .need_comma = false,
@@ -61,6 +64,207 @@ AZ_NODISCARD az_result az_json_writer_chunked_init(
   return AZ_OK;
 }
 
+AZ_NODISCARD az_result
+az_json_writer_sizing_init(az_json_writer* out_json_writer, az_json_writer_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_writer);
+
+  *out_json_writer = (az_json_writer){
+    ._internal = {
+      .destination_buffer = AZ_SPAN_EMPTY,
+      .allocator_callback = NULL,
+      .user_context = NULL,
+      .is_sizing = true,
+      .bytes_written = 0,
+      .total_bytes_written = 0,
+      .need_comma = false,
+      .token_kind = AZ_JSON_TOKEN_NONE,
+      .bit_stack = { 0 },
+      .options = options == NULL ? az_json_writer_options_default() : *options,
+    },
+  };
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_writer_chunk_pool_init(
+    az_json_writer_chunk_pool* out_chunk_pool,
+    az_span chunks[],
+    int32_t number_of_chunks,
+    az_json_writer_segment segments[],
+    int32_t segments_size)
+{
+  _az_PRECONDITION_NOT_NULL(out_chunk_pool);
+  _az_PRECONDITION_NOT_NULL(chunks);
+  _az_PRECONDITION(number_of_chunks > 0);
+  _az_PRECONDITION_NOT_NULL(segments);
+  _az_PRECONDITION(segments_size > 0);
+
+  *out_chunk_pool = (az_json_writer_chunk_pool){
+    ._internal = {
+      .chunks = chunks,
+      .number_of_chunks = number_of_chunks,
+      .next_chunk_index = 0,
+      .segments = segments,
+      .segments_size = segments_size,
+      .number_of_segments = 0,
+    },
+  };
+  return AZ_OK;
+}
+
+// The az_span_allocator_fn of writers initialized by az_json_writer_pooled_init(), which records
+// the text written into the previous chunk as a segment, and moves on to the next chunk that is
+// large enough.
+AZ_NODISCARD static az_result _az_json_writer_chunk_pool_allocate(
+    az_span_allocator_context* allocator_context,
+    az_span* out_next_destination)
+{
+  az_json_writer_chunk_pool* const chunk_pool
+      = (az_json_writer_chunk_pool*)allocator_context->user_context;
+
+  // Chunks that are too small for the next token are skipped.
+  int32_t next_chunk_index = chunk_pool->_internal.next_chunk_index;
+  while (next_chunk_index < chunk_pool->_internal.number_of_chunks
+         && az_span_size(chunk_pool->_internal.chunks[next_chunk_index])
+             < allocator_context->minimum_required_size)
+  {
+    next_chunk_index++;
+  }
+
+  if (next_chunk_index >= chunk_pool->_internal.number_of_chunks)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  // Nothing needs to be recorded for a chunk that nothing was written into.
+  if (allocator_context->bytes_used > 0)
+  {
+    if (chunk_pool->_internal.number_of_segments >= chunk_pool->_internal.segments_size)
+    {
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
+    az_span const previous_chunk
+        = chunk_pool->_internal.chunks[chunk_pool->_internal.next_chunk_index - 1];
+    chunk_pool->_internal.segments[chunk_pool->_internal.number_of_segments]
+        = (az_json_writer_segment){
+            .base = az_span_ptr(previous_chunk),
+            .size = (size_t)allocator_context->bytes_used,
+          };
+    chunk_pool->_internal.number_of_segments++;
+  }
+
+  *out_next_destination = chunk_pool->_internal.chunks[next_chunk_index];
+  chunk_pool->_internal.next_chunk_index = next_chunk_index + 1;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_writer_pooled_init(
+    az_json_writer* out_json_writer,
+    az_json_writer_chunk_pool* ref_chunk_pool,
+    az_json_writer_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_writer);
+  _az_PRECONDITION_NOT_NULL(ref_chunk_pool);
+  _az_PRECONDITION(
+      ref_chunk_pool->_internal.next_chunk_index < ref_chunk_pool->_internal.number_of_chunks);
+
+  az_span const first_chunk
+      = ref_chunk_pool->_internal.chunks[ref_chunk_pool->_internal.next_chunk_index];
+  ref_chunk_pool->_internal.next_chunk_index++;
+
+  return az_json_writer_chunked_init(
+      out_json_writer, first_chunk, _az_json_writer_chunk_pool_allocate, ref_chunk_pool, options);
+}
+
+AZ_NODISCARD az_result az_json_writer_chunk_pool_get_segments(
+    az_json_writer_chunk_pool* ref_chunk_pool,
+    az_json_writer const* json_writer,
+    int32_t* out_number_of_segments)
+{
+  _az_PRECONDITION_NOT_NULL(ref_chunk_pool);
+  _az_PRECONDITION_NOT_NULL(json_writer);
+  _az_PRECONDITION(json_writer->_internal.user_context == ref_chunk_pool);
+  _az_PRECONDITION_NOT_NULL(out_number_of_segments);
+
+  int32_t number_of_segments = ref_chunk_pool->_internal.number_of_segments;
+
+  // The text within the current chunk isn't recorded by the allocator, since the writer hasn't
+  // moved past it, so it is added after the others without being counted by the pool. That way,
+  // this can be called again after writing more.
+  az_span const last_segment = az_json_writer_get_bytes_used_in_destination(json_writer);
+  if (az_span_size(last_segment) > 0)
+  {
+    if (number_of_segments >= ref_chunk_pool->_internal.segments_size)
+    {
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
+    ref_chunk_pool->_internal.segments[number_of_segments] = (az_json_writer_segment){
+      .base = az_span_ptr(last_segment),
+      .size = (size_t)az_span_size(last_segment),
+    };
+    number_of_segments++;
+  }
+
+  *out_number_of_segments = number_of_segments;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_json_writer_checkpoint
+az_json_writer_get_checkpoint(az_json_writer const* json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(json_writer);
+
+  return (az_json_writer_checkpoint){
+    ._internal = {
+      .destination_buffer = json_writer->_internal.destination_buffer,
+      .bytes_written = json_writer->_internal.bytes_written,
+      .total_bytes_written = json_writer->_internal.total_bytes_written,
+      .need_comma = json_writer->_internal.need_comma,
+      .token_kind = json_writer->_internal.token_kind,
+      .bit_stack = json_writer->_internal.bit_stack,
+    },
+  };
+}
+
+void az_json_writer_rollback(
+    az_json_writer* ref_json_writer,
+    az_json_writer_checkpoint const* checkpoint)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_NOT_NULL(checkpoint);
+
+  // The text written before the checkpoint must still be in the destination buffer, which means
+  // that the writer hasn't moved to another buffer, or been flushed, since then.
+  _az_PRECONDITION(
+      az_span_ptr(ref_json_writer->_internal.destination_buffer)
+      == az_span_ptr(checkpoint->_internal.destination_buffer));
+  _az_PRECONDITION(
+      ref_json_writer->_internal.total_bytes_written - ref_json_writer->_internal.bytes_written
+      <= checkpoint->_internal.total_bytes_written - checkpoint->_internal.bytes_written);
+
+  ref_json_writer->_internal.destination_buffer = checkpoint->_internal.destination_buffer;
+  ref_json_writer->_internal.bytes_written = checkpoint->_internal.bytes_written;
+  ref_json_writer->_internal.total_bytes_written = checkpoint->_internal.total_bytes_written;
+  ref_json_writer->_internal.need_comma = checkpoint->_internal.need_comma;
+  ref_json_writer->_internal.token_kind = checkpoint->_internal.token_kind;
+  ref_json_writer->_internal.bit_stack = checkpoint->_internal.bit_stack;
+}
+
+AZ_NODISCARD az_result
+az_json_writer_flush(az_json_writer* ref_json_writer, az_span* out_json_text)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_NOT_NULL(out_json_text);
+
+  *out_json_text = az_json_writer_get_bytes_used_in_destination(ref_json_writer);
+
+  // Only the position within the buffer is reset. The total keeps counting all of the text written.
+  ref_json_writer->_internal.bytes_written = 0;
+  return AZ_OK;
+}
+
 static AZ_NODISCARD az_span
 _get_remaining_span(az_json_writer* ref_json_writer, int32_t required_size)
 {
@@ -199,12 +403,7 @@ static AZ_NODISCARD bool _az_is_appending_container_end_valid(
 }
 #endif // AZ_NO_PRECONDITION_CHECKING
 
-// Returns the length of the JSON string within the az_span after it has been escaped.
-// The out parameter contains the index where the first character to escape is found.
-// If no chars need to be escaped then return the size of value with the out parameter set to -1.
-// If break_on_first_escaped is set to true, then it returns as soon as the first character to
-// escape is found.
-static int32_t _az_json_writer_escaped_length(
+int32_t _az_json_writer_escaped_length(
     az_span value,
     int32_t* out_index_of_first_escaped_char,
     bool break_on_first_escaped)
@@ -223,9 +422,26 @@ static int32_t _az_json_writer_escaped_length(
 
   while (i < value_size)
   {
-    uint8_t const ch = value_ptr[i];
+    // Most characters don't need to be escaped, so runs of them are skipped several bytes at a
+    // time.
+    int32_t const plain_bytes
+        = _az_simd_json_count_plain_string_bytes(value_ptr + i, value_size - i);
+    i += plain_bytes;
+    escaped_length += plain_bytes;
+
+    if (i == value_size)
+    {
+      break;
+    }
+
+    // If this is the first time that we found a character that needs to be escaped,
+    // set out_index_of_first_escaped_char to the corresponding index.
+    if (*out_index_of_first_escaped_char == -1)
+    {
+      *out_index_of_first_escaped_char = i;
+    }
 
-    switch (ch)
+    switch (value_ptr[i])
     {
       case '\\':
       case '"':
@@ -240,31 +456,17 @@ static int32_t _az_json_writer_escaped_length(
       }
       default:
       {
-        // Check if the character has to be escaped as a UNICODE escape sequence.
-        if (ch < _az_ASCII_SPACE_CHARACTER)
-        {
-          escaped_length += _az_MAX_EXPANSION_FACTOR_WHILE_ESCAPING;
-        }
-        else
-        {
-          escaped_length++; // No escaping required.
-        }
+        // Any other control character has to be escaped as a UNICODE escape sequence.
+        escaped_length += _az_MAX_EXPANSION_FACTOR_WHILE_ESCAPING;
         break;
       }
     }
 
     i++;
 
-    // If this is the first time that we found a character that needs to be escaped,
-    // set out_index_of_first_escaped_char to the corresponding index.
-    // If escaped_length == i, then we haven't found a character that needs to be escaped yet.
-    if (escaped_length != i && *out_index_of_first_escaped_char == -1)
+    if (break_on_first_escaped)
     {
-      *out_index_of_first_escaped_char = i - 1;
-      if (break_on_first_escaped)
-      {
-        break;
-      }
+      break;
     }
 
     // If the length overflows, in case the precondition is not honored, stop processing and break
@@ -360,7 +562,7 @@ static int32_t _az_json_writer_escape_next_byte_and_copy(
   return written;
 }
 
-static AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination, az_span source)
+AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination, az_span source)
 {
   _az_PRECONDITION_VALID_SPAN(source, 1, false);
 
@@ -375,9 +577,18 @@ static AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination,
 
   while (i < src_size)
   {
-    uint8_t const ch = value_ptr[i];
-    _az_json_writer_escape_next_byte_and_copy(&remaining_destination, ch);
-    i++;
+    // Bulk copy the run of characters that don't need to be escaped, before escaping the one that
+    // follows it.
+    int32_t const plain_bytes = _az_simd_json_count_plain_string_bytes(value_ptr + i, src_size - i);
+    remaining_destination
+        = az_span_copy(remaining_destination, az_span_slice(source, i, i + plain_bytes));
+    i += plain_bytes;
+
+    if (i < src_size)
+    {
+      _az_json_writer_escape_next_byte_and_copy(&remaining_destination, value_ptr[i]);
+      i++;
+    }
   }
 
   return remaining_destination;
@@ -396,6 +607,30 @@ AZ_INLINE void _az_update_json_writer_state(
   ref_json_writer->_internal.token_kind = token_kind;
 }
 
+// When sizing, nothing is written, and only the number of bytes that would have been written, along
+// with the state needed to validate the next appends, is kept track of.
+static AZ_NODISCARD az_result _az_json_writer_count(
+    az_json_writer* ref_json_writer,
+    int32_t required_size,
+    bool need_comma,
+    az_json_token_kind token_kind)
+{
+  _az_update_json_writer_state(ref_json_writer, 0, required_size, need_comma, token_kind);
+  return AZ_OK;
+}
+
+// Gives the number of bytes needed to append a string or property name, including the leading comma
+// separator, without writing it.
+static AZ_NODISCARD int32_t
+_az_json_writer_get_escaped_text_size(az_json_writer const* json_writer, az_span value)
+{
+  int32_t index_of_first_escaped_char = -1;
+  int32_t const escaped_size
+      = _az_json_writer_escaped_length(value, &index_of_first_escaped_char, false);
+
+  return (json_writer->_internal.need_comma ? 1 : 0) + escaped_size;
+}
+
 static AZ_NODISCARD az_result az_json_writer_span_copy_chunked(
     az_json_writer* ref_json_writer,
     az_span* remaining_json,
@@ -431,7 +666,9 @@ static AZ_NODISCARD az_result az_json_writer_span_copy_chunked(
 static AZ_NODISCARD az_result
 az_json_writer_append_string_small(az_json_writer* ref_json_writer, az_span value)
 {
-  _az_PRECONDITION(az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK);
+  _az_PRECONDITION(
+      az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK
+      || ref_json_writer->_internal.allocator_callback == NULL);
 
   int32_t required_size = 2; // For the surrounding quotes.
 
@@ -443,7 +680,9 @@ az_json_writer_append_string_small(az_json_writer* ref_json_writer, az_span valu
   int32_t index_of_first_escaped_char = -1;
   required_size += _az_json_writer_escaped_length(value, &index_of_first_escaped_char, false);
 
-  _az_PRECONDITION(required_size <= _az_MINIMUM_STRING_CHUNK_SIZE);
+  _az_PRECONDITION(
+      required_size <= _az_MINIMUM_STRING_CHUNK_SIZE
+      || ref_json_writer->_internal.allocator_callback == NULL);
 
   az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
   _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
@@ -561,7 +800,22 @@ AZ_NODISCARD az_result az_json_writer_append_string(az_json_writer* ref_json_wri
   _az_PRECONDITION(az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE);
   _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
 
-  if (az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK)
+  if (ref_json_writer->_internal.options.validate_utf8 && !_az_span_is_valid_utf8(value))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    // For the surrounding quotes.
+    int32_t const required_size = _az_json_writer_get_escaped_text_size(ref_json_writer, value) + 2;
+    return _az_json_writer_count(ref_json_writer, required_size, true, AZ_JSON_TOKEN_STRING);
+  }
+
+  // A single destination buffer doesn't need to be written a chunk at a time, so the string is
+  // written in one go, needing no more space than its escaped text.
+  if (az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK
+      || ref_json_writer->_internal.allocator_callback == NULL)
   {
     return az_json_writer_append_string_small(ref_json_writer, value);
   }
@@ -572,7 +826,9 @@ AZ_NODISCARD az_result az_json_writer_append_string(az_json_writer* ref_json_wri
 static AZ_NODISCARD az_result
 az_json_writer_append_property_name_small(az_json_writer* ref_json_writer, az_span value)
 {
-  _az_PRECONDITION(az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK);
+  _az_PRECONDITION(
+      az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK
+      || ref_json_writer->_internal.allocator_callback == NULL);
 
   int32_t required_size = 3; // For the surrounding quotes and the key:value separator colon.
 
@@ -584,7 +840,9 @@ az_json_writer_append_property_name_small(az_json_writer* ref_json_writer, az_sp
   int32_t index_of_first_escaped_char = -1;
   required_size += _az_json_writer_escaped_length(value, &index_of_first_escaped_char, false);
 
-  _az_PRECONDITION(required_size <= _az_MINIMUM_STRING_CHUNK_SIZE);
+  _az_PRECONDITION(
+      required_size <= _az_MINIMUM_STRING_CHUNK_SIZE
+      || ref_json_writer->_internal.allocator_callback == NULL);
 
   az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
   _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
@@ -706,7 +964,22 @@ az_json_writer_append_property_name(az_json_writer* ref_json_writer, az_span nam
   _az_PRECONDITION(az_span_size(name) <= _az_MAX_UNESCAPED_STRING_SIZE);
   _az_PRECONDITION(_az_is_appending_property_name_valid(ref_json_writer));
 
-  if (az_span_size(name) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK)
+  if (ref_json_writer->_internal.options.validate_utf8 && !_az_span_is_valid_utf8(name))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    // For the surrounding quotes and the key:value separator colon.
+    int32_t const required_size = _az_json_writer_get_escaped_text_size(ref_json_writer, name) + 3;
+    return _az_json_writer_count(
+        ref_json_writer, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+  }
+
+  // A single destination buffer doesn't need to be written a chunk at a time.
+  if (az_span_size(name) <= _az_MAX_UNESCAPED_STRING_SIZE_PER_CHUNK
+      || ref_json_writer->_internal.allocator_callback == NULL)
   {
     return az_json_writer_append_property_name_small(ref_json_writer, name);
   }
@@ -714,6 +987,162 @@ az_json_writer_append_property_name(az_json_writer* ref_json_writer, az_span nam
   return az_json_writer_append_property_name_chunked(ref_json_writer, name);
 }
 
+AZ_NODISCARD az_result az_json_prepared_property_name_init(
+    az_json_prepared_property_name* out_property_name,
+    az_span name,
+    az_span buffer)
+{
+  _az_PRECONDITION_NOT_NULL(out_property_name);
+  _az_PRECONDITION_VALID_SPAN(name, 0, false);
+  _az_PRECONDITION(az_span_size(name) <= _az_MAX_UNESCAPED_STRING_SIZE);
+  _az_PRECONDITION_VALID_SPAN(buffer, 0, false);
+
+  // For the leading comma separator, the surrounding quotes, and the key:value separator colon.
+  int32_t required_size = 4;
+
+  int32_t index_of_first_escaped_char = -1;
+  required_size += _az_json_writer_escaped_length(name, &index_of_first_escaped_char, false);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(buffer, required_size);
+
+  az_span remaining = az_span_copy_u8(buffer, ',');
+  remaining = az_span_copy_u8(remaining, '"');
+
+  if (index_of_first_escaped_char == -1)
+  {
+    remaining = az_span_copy(remaining, name);
+  }
+  else
+  {
+    remaining = az_span_copy(remaining, az_span_slice(name, 0, index_of_first_escaped_char));
+    remaining = _az_json_writer_escape_and_copy(
+        remaining, az_span_slice_to_end(name, index_of_first_escaped_char));
+  }
+
+  remaining = az_span_copy_u8(remaining, '"');
+  az_span_copy_u8(remaining, ':');
+
+  out_property_name->_internal.text = az_span_slice(buffer, 0, required_size);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_writer_append_prepared_property_name(
+    az_json_writer* ref_json_writer,
+    az_json_prepared_property_name const* property_name)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_NOT_NULL(property_name);
+  _az_PRECONDITION_VALID_SPAN(property_name->_internal.text, 4, false);
+  _az_PRECONDITION(_az_is_appending_property_name_valid(ref_json_writer));
+
+  // The leading comma separator is only copied when it is needed.
+  az_span text = property_name->_internal.text;
+  if (!ref_json_writer->_internal.need_comma)
+  {
+    text = az_span_slice_to_end(text, 1);
+  }
+
+  int32_t const required_size = az_span_size(text);
+
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    return _az_json_writer_count(
+        ref_json_writer, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+  }
+
+  if (required_size <= _az_MINIMUM_STRING_CHUNK_SIZE
+      || ref_json_writer->_internal.allocator_callback == NULL)
+  {
+    az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+    az_span_copy(remaining_json, text);
+
+    _az_update_json_writer_state(
+        ref_json_writer, required_size, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+    return AZ_OK;
+  }
+
+  // Longer property names are copied a chunk at a time, in the same way as when they are escaped
+  // while being appended.
+  az_span remaining_json = _get_remaining_span(ref_json_writer, _az_MINIMUM_STRING_CHUNK_SIZE);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, _az_MINIMUM_STRING_CHUNK_SIZE);
+  _az_RETURN_IF_FAILED(az_json_writer_span_copy_chunked(ref_json_writer, &remaining_json, text));
+
+  // We already tracked and updated bytes_written while writing, so no need to update it here.
+  _az_update_json_writer_state(
+      ref_json_writer, 0, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+_az_json_writer_append_raw_property_name(az_json_writer* ref_json_writer, az_span escaped_name)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_VALID_SPAN(escaped_name, 0, true);
+  _az_PRECONDITION(_az_is_appending_property_name_valid(ref_json_writer));
+
+  int32_t required_size = az_span_size(escaped_name) + 3; // For the quotes and the colon.
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    return _az_json_writer_count(
+        ref_json_writer, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+  }
+
+  if (required_size <= _az_MINIMUM_STRING_CHUNK_SIZE
+      || ref_json_writer->_internal.allocator_callback == NULL)
+  {
+    az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+    if (ref_json_writer->_internal.need_comma)
+    {
+      remaining_json = az_span_copy_u8(remaining_json, ',');
+    }
+    remaining_json = az_span_copy_u8(remaining_json, '"');
+    remaining_json = az_span_copy(remaining_json, escaped_name);
+    remaining_json = az_span_copy_u8(remaining_json, '"');
+    az_span_copy_u8(remaining_json, ':');
+
+    _az_update_json_writer_state(
+        ref_json_writer, required_size, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+    return AZ_OK;
+  }
+
+  // Longer property names are copied a chunk at a time.
+  az_span remaining_json = _get_remaining_span(ref_json_writer, _az_MINIMUM_STRING_CHUNK_SIZE);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, _az_MINIMUM_STRING_CHUNK_SIZE);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+    ref_json_writer->_internal.bytes_written++;
+  }
+
+  remaining_json = az_span_copy_u8(remaining_json, '"');
+  ref_json_writer->_internal.bytes_written++;
+
+  _az_RETURN_IF_FAILED(
+      az_json_writer_span_copy_chunked(ref_json_writer, &remaining_json, escaped_name));
+
+  remaining_json = _get_remaining_span(ref_json_writer, _az_MINIMUM_STRING_CHUNK_SIZE);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, _az_MINIMUM_STRING_CHUNK_SIZE);
+
+  remaining_json = az_span_copy_u8(remaining_json, '"');
+  az_span_copy_u8(remaining_json, ':');
+  ref_json_writer->_internal.bytes_written += 2;
+
+  // We already tracked and updated bytes_written while writing, so no need to update it here.
+  _az_update_json_writer_state(
+      ref_json_writer, 0, required_size, false, AZ_JSON_TOKEN_PROPERTY_NAME);
+  return AZ_OK;
+}
+
 static AZ_NODISCARD az_result _az_validate_json(
     az_span json_text,
     az_json_token_kind* first_token_kind,
@@ -749,34 +1178,38 @@ static AZ_NODISCARD az_result _az_validate_json(
   return AZ_OK;
 }
 
-AZ_NODISCARD az_result
-az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_text)
+AZ_NODISCARD az_result _az_json_writer_append_raw_value(
+    az_json_writer* ref_json_writer,
+    az_span json_text,
+    az_json_token_kind last_token_kind)
 {
   _az_PRECONDITION_NOT_NULL(ref_json_writer);
-  // A null or empty span is not allowed since that is invalid JSON.
-  _az_PRECONDITION_VALID_SPAN(json_text, 0, false);
-
-  az_json_token_kind first_token_kind = AZ_JSON_TOKEN_NONE;
-  az_json_token_kind last_token_kind = AZ_JSON_TOKEN_NONE;
+  _az_PRECONDITION_VALID_SPAN(json_text, 1, false);
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
 
-  // This runtime validation is necessary since the input could be user defined and malformed.
-  // This cannot be caught at dev time by a precondition, especially since they can be turned off.
-  _az_RETURN_IF_FAILED(_az_validate_json(json_text, &first_token_kind, &last_token_kind));
+  int32_t const required_size
+      = (ref_json_writer->_internal.need_comma ? 1 : 0) + az_span_size(json_text);
 
-  // It is guaranteed that first_token_kind is NOT:
-  // AZ_JSON_TOKEN_NONE, AZ_JSON_TOKEN_END_ARRAY, AZ_JSON_TOKEN_END_OBJECT,
-  // AZ_JSON_TOKEN_PROPERTY_NAME
-  // And that last_token_kind is NOT:
-  // AZ_JSON_TOKEN_NONE, AZ_JSON_TOKEN_START_ARRAY, AZ_JSON_TOKEN_START_OBJECT,
-  // AZ_JSON_TOKEN_PROPERTY_NAME
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    return _az_json_writer_count(ref_json_writer, required_size, true, last_token_kind);
+  }
 
-  // The JSON text is valid, but appending it to the the JSON writer at the current state still may
-  // not be valid.
-  if (!_az_is_appending_value_valid(ref_json_writer))
+  // A single destination buffer doesn't need to be written a chunk at a time.
+  if (ref_json_writer->_internal.allocator_callback == NULL)
   {
-    // All other tokens, including start array and object are validated here.
-    // Also first_token_kind cannot be AZ_JSON_TOKEN_NONE at this point.
-    return AZ_ERROR_JSON_INVALID_STATE;
+    az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+    if (ref_json_writer->_internal.need_comma)
+    {
+      remaining_json = az_span_copy_u8(remaining_json, ',');
+    }
+    az_span_copy(remaining_json, json_text);
+
+    _az_update_json_writer_state(
+        ref_json_writer, required_size, required_size, true, last_token_kind);
+    return AZ_OK;
   }
 
   az_span remaining_json = _get_remaining_span(ref_json_writer, _az_MINIMUM_STRING_CHUNK_SIZE);
@@ -803,6 +1236,73 @@ az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_te
   return AZ_OK;
 }
 
+AZ_NODISCARD az_result _az_json_writer_append_reader_value(
+    az_json_writer* ref_json_writer,
+    az_json_reader* ref_json_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_NOT_NULL(ref_json_reader);
+  _az_PRECONDITION(ref_json_reader->_internal.number_of_buffers == 1);
+
+  az_json_token const first_token = ref_json_reader->token;
+  uint8_t* start = az_span_ptr(first_token.slice);
+  uint8_t* end = start + az_span_size(first_token.slice);
+
+  if (first_token.kind == AZ_JSON_TOKEN_STRING)
+  {
+    // The slice of a string token doesn't include its quotes.
+    start--;
+    end++;
+  }
+  else if (
+      first_token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+      || first_token.kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_json_reader));
+
+    az_span const last_slice = ref_json_reader->token.slice;
+    end = az_span_ptr(last_slice) + az_span_size(last_slice);
+  }
+
+  return _az_json_writer_append_raw_value(
+      ref_json_writer,
+      az_span_create(start, (int32_t)(end - start)),
+      ref_json_reader->token.kind);
+}
+
+AZ_NODISCARD az_result
+az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_text)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  // A null or empty span is not allowed since that is invalid JSON.
+  _az_PRECONDITION_VALID_SPAN(json_text, 0, false);
+
+  az_json_token_kind first_token_kind = AZ_JSON_TOKEN_NONE;
+  az_json_token_kind last_token_kind = AZ_JSON_TOKEN_NONE;
+
+  // This runtime validation is necessary since the input could be user defined and malformed.
+  // This cannot be caught at dev time by a precondition, especially since they can be turned off.
+  _az_RETURN_IF_FAILED(_az_validate_json(json_text, &first_token_kind, &last_token_kind));
+
+  // It is guaranteed that first_token_kind is NOT:
+  // AZ_JSON_TOKEN_NONE, AZ_JSON_TOKEN_END_ARRAY, AZ_JSON_TOKEN_END_OBJECT,
+  // AZ_JSON_TOKEN_PROPERTY_NAME
+  // And that last_token_kind is NOT:
+  // AZ_JSON_TOKEN_NONE, AZ_JSON_TOKEN_START_ARRAY, AZ_JSON_TOKEN_START_OBJECT,
+  // AZ_JSON_TOKEN_PROPERTY_NAME
+
+  // The JSON text is valid, but appending it to the the JSON writer at the current state still may
+  // not be valid.
+  if (!_az_is_appending_value_valid(ref_json_writer))
+  {
+    // All other tokens, including start array and object are validated here.
+    // Also first_token_kind cannot be AZ_JSON_TOKEN_NONE at this point.
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  return _az_json_writer_append_raw_value(ref_json_writer, json_text, last_token_kind);
+}
+
 static AZ_NODISCARD az_result _az_json_writer_append_literal(
     az_json_writer* ref_json_writer,
     az_span literal,
@@ -823,6 +1323,11 @@ static AZ_NODISCARD az_result _az_json_writer_append_literal(
     required_size++; // For the leading comma separator.
   }
 
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    return _az_json_writer_count(ref_json_writer, required_size, true, literal_kind);
+  }
+
   az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
   _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
 
@@ -856,13 +1361,21 @@ AZ_NODISCARD az_result az_json_writer_append_int32(az_json_writer* ref_json_writ
   _az_PRECONDITION_NOT_NULL(ref_json_writer);
   _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
 
-  int32_t required_size = _az_MAX_SIZE_FOR_INT32; // Need enough space to write any 32-bit integer.
+  // The number of digits is found without writing them, or dividing the number, so that only as
+  // much space as the number needs is asked for.
+  uint32_t const magnitude = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+  int32_t required_size = (value < 0 ? 1 : 0) + _az_span_u32toa_size(magnitude);
 
   if (ref_json_writer->_internal.need_comma)
   {
     required_size++; // For the leading comma separator.
   }
 
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    return _az_json_writer_count(ref_json_writer, required_size, true, AZ_JSON_TOKEN_NUMBER);
+  }
+
   az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
   _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
 
@@ -871,17 +1384,53 @@ AZ_NODISCARD az_result az_json_writer_append_int32(az_json_writer* ref_json_writ
     remaining_json = az_span_copy_u8(remaining_json, ',');
   }
 
-  // Since we asked for the maximum needed space above, this is guaranteed not to fail due to
+  // Since we asked for the exact space needed above, this is guaranteed not to fail due to
   // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
   // cases.
   az_span leftover;
   _az_RETURN_IF_FAILED(az_span_i32toa(remaining_json, value, &leftover));
 
-  // We already accounted for the maximum size needed in required_size, so subtract that to get the
-  // actual bytes written.
-  int32_t written
-      = required_size + _az_span_diff(leftover, remaining_json) - _az_MAX_SIZE_FOR_INT32;
-  _az_update_json_writer_state(ref_json_writer, written, written, true, AZ_JSON_TOKEN_NUMBER);
+  _az_update_json_writer_state(
+      ref_json_writer, required_size, required_size, true, AZ_JSON_TOKEN_NUMBER);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_writer_append_int64(az_json_writer* ref_json_writer, int64_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
+
+  // The number of digits is found without writing them, or dividing the number, so that only as
+  // much space as the number needs is asked for.
+  uint64_t const magnitude = value < 0 ? 0U - (uint64_t)value : (uint64_t)value;
+  int32_t required_size = (value < 0 ? 1 : 0) + _az_span_u64toa_size(magnitude);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    return _az_json_writer_count(ref_json_writer, required_size, true, AZ_JSON_TOKEN_NUMBER);
+  }
+
+  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+  }
+
+  // Since we asked for the exact space needed above, this is guaranteed not to fail due to
+  // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
+  // cases.
+  az_span leftover;
+  _az_RETURN_IF_FAILED(az_span_i64toa(remaining_json, value, &leftover));
+
+  _az_update_json_writer_state(
+      ref_json_writer, required_size, required_size, true, AZ_JSON_TOKEN_NUMBER);
   return AZ_OK;
 }
 
@@ -905,15 +1454,24 @@ AZ_NODISCARD az_result az_json_writer_append_double(
     required_size++; // For the leading comma separator.
   }
 
-  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+  bool const is_sizing = ref_json_writer->_internal.is_sizing;
+  az_span const destination
+      = is_sizing ? AZ_SPAN_EMPTY : _get_remaining_span(ref_json_writer, required_size);
+
+  // When sizing, or when there is less space left than any number needs, the number is formatted
+  // into a scratch buffer first, to find its length.
+  uint8_t scratch_buffer[_az_MAX_SIZE_FOR_WRITING_DOUBLE + 1];
+  az_span const number_destination = az_span_size(destination) < required_size
+      ? AZ_SPAN_FROM_BUFFER(scratch_buffer)
+      : destination;
+  az_span remaining_json = number_destination;
 
   if (ref_json_writer->_internal.need_comma)
   {
     remaining_json = az_span_copy_u8(remaining_json, ',');
   }
 
-  // Since we asked for the maximum needed space above, this is guaranteed not to fail due to
+  // Since the maximum needed space is available, this is guaranteed not to fail due to
   // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
   // cases.
   az_span leftover;
@@ -923,7 +1481,71 @@ AZ_NODISCARD az_result az_json_writer_append_double(
   // actual bytes written.
   int32_t written
       = required_size + _az_span_diff(leftover, remaining_json) - _az_MAX_SIZE_FOR_WRITING_DOUBLE;
-  _az_update_json_writer_state(ref_json_writer, written, written, true, AZ_JSON_TOKEN_NUMBER);
+
+  if (!is_sizing && az_span_ptr(number_destination) == scratch_buffer)
+  {
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, written);
+    az_span_copy(destination, az_span_slice(number_destination, 0, written));
+  }
+
+  _az_update_json_writer_state(
+      ref_json_writer, is_sizing ? 0 : written, written, true, AZ_JSON_TOKEN_NUMBER);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_writer_append_double_shortest(az_json_writer* ref_json_writer, double value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
+  // Non-finite numbers are not supported because they lead to invalid JSON.
+  // Unquoted strings such as nan and -inf are invalid as JSON numbers.
+  _az_PRECONDITION(_az_isfinite(value));
+
+  // Need enough space to write any double number.
+  int32_t required_size = _az_MAX_SIZE_FOR_WRITING_SHORTEST_DOUBLE;
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  bool const is_sizing = ref_json_writer->_internal.is_sizing;
+  az_span const destination
+      = is_sizing ? AZ_SPAN_EMPTY : _get_remaining_span(ref_json_writer, required_size);
+
+  // When sizing, or when there is less space left than any number needs, the number is formatted
+  // into a scratch buffer first, to find its length.
+  uint8_t scratch_buffer[_az_MAX_SIZE_FOR_WRITING_SHORTEST_DOUBLE + 1];
+  az_span const number_destination = az_span_size(destination) < required_size
+      ? AZ_SPAN_FROM_BUFFER(scratch_buffer)
+      : destination;
+  az_span remaining_json = number_destination;
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+  }
+
+  // Since the maximum needed space is available, this is guaranteed not to fail due to
+  // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
+  // cases.
+  az_span leftover;
+  _az_RETURN_IF_FAILED(az_span_dtoa_shortest(remaining_json, value, &leftover));
+
+  // We already accounted for the maximum size needed in required_size, so subtract that to get the
+  // actual bytes written.
+  int32_t written = required_size + _az_span_diff(leftover, remaining_json)
+      - _az_MAX_SIZE_FOR_WRITING_SHORTEST_DOUBLE;
+
+  if (!is_sizing && az_span_ptr(number_destination) == scratch_buffer)
+  {
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, written);
+    az_span_copy(destination, az_span_slice(number_destination, 0, written));
+  }
+
+  _az_update_json_writer_state(
+      ref_json_writer, is_sizing ? 0 : written, written, true, AZ_JSON_TOKEN_NUMBER);
   return AZ_OK;
 }
 
@@ -951,18 +1573,25 @@ static AZ_NODISCARD az_result _az_json_writer_append_container_start(
     required_size++; // For the leading comma separator.
   }
 
-  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
-
-  if (ref_json_writer->_internal.need_comma)
+  if (ref_json_writer->_internal.is_sizing)
   {
-    remaining_json = az_span_copy_u8(remaining_json, ',');
+    _az_update_json_writer_state(ref_json_writer, 0, required_size, false, container_kind);
   }
+  else
+  {
+    az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
 
-  az_span_copy_u8(remaining_json, byte);
+    if (ref_json_writer->_internal.need_comma)
+    {
+      remaining_json = az_span_copy_u8(remaining_json, ',');
+    }
 
-  _az_update_json_writer_state(
-      ref_json_writer, required_size, required_size, false, container_kind);
+    az_span_copy_u8(remaining_json, byte);
+
+    _az_update_json_writer_state(
+        ref_json_writer, required_size, required_size, false, container_kind);
+  }
   if (container_kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
   {
     _az_json_stack_push(&ref_json_writer->_internal.bit_stack, _az_JSON_STACK_OBJECT);
@@ -997,12 +1626,20 @@ static AZ_NODISCARD az_result az_json_writer_append_container_end(
 
   int32_t required_size = 1; // For the end object or array byte.
 
-  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+  if (ref_json_writer->_internal.is_sizing)
+  {
+    _az_update_json_writer_state(ref_json_writer, 0, required_size, true, container_kind);
+  }
+  else
+  {
+    az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
 
-  az_span_copy_u8(remaining_json, byte);
+    az_span_copy_u8(remaining_json, byte);
 
-  _az_update_json_writer_state(ref_json_writer, required_size, required_size, true, container_kind);
+    _az_update_json_writer_state(
+        ref_json_writer, required_size, required_size, true, container_kind);
+  }
   _az_json_stack_pop(&ref_json_writer->_internal.bit_stack);
 
   return AZ_OK;
@@ -0,0 +1,410 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#ifndef _az_SIMD_PRIVATE_H
+#define _az_SIMD_PRIVATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// SSE2 is part of the x86-64 baseline, so it is always available there. Every other target (for
+// example, the microcontrollers most of the SDK runs on) uses the portable scalar implementation.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define _az_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <azure/core/_az_cfg_prefix.h>
+
+enum
+{
+  // The number of bytes classified at once by _az_simd_json_classify_nesting_block, one bit per
+  // byte in a uint64_t mask.
+  _az_SIMD_JSON_BLOCK_SIZE = 64,
+};
+
+/**
+ * @brief Returns the index of the least significant set bit of a non-zero \p value.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_simd_count_trailing_zeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (int32_t)__builtin_ctzll(value);
+#else
+  // De Bruijn sequence lookup, used on compilers without a portable bit scan intrinsic.
+  static uint8_t const debruijn_positions[64]
+      = { 0,  1,  2,  53, 3,  7,  54, 27, 4,  38, 41, 8,  34, 55, 48, 28, 62, 5,  39, 46, 44, 42,
+          22, 9,  24, 35, 59, 56, 49, 18, 29, 11, 63, 52, 6,  26, 37, 40, 33, 47, 61, 45, 43, 21,
+          23, 58, 17, 10, 51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12 };
+  uint64_t const isolated = value & (~value + 1);
+  return debruijn_positions[(isolated * 0x022FDD63CC95386DULL) >> 58U];
+#endif
+}
+
+/**
+ * @brief Computes, for every bit of \p value, the XOR of itself and all the bits below it.
+ *
+ * @details Applied to the mask of unescaped quotes, this sets the bits of every byte that is within
+ * a JSON string (including the opening quote, but not the closing one).
+ */
+AZ_NODISCARD AZ_INLINE uint64_t _az_simd_prefix_xor(uint64_t value)
+{
+  value ^= value << 1U;
+  value ^= value << 2U;
+  value ^= value << 4U;
+  value ^= value << 8U;
+  value ^= value << 16U;
+  value ^= value << 32U;
+  return value;
+}
+
+/**
+ * @brief Finds which bytes of a block are escaped by a preceding backslash.
+ *
+ * @param[in] backslash The mask of backslash bytes within the block.
+ * @param[in,out] ref_prev_escaped Set to 1 if the first byte of the block is escaped by a backslash
+ * at the end of the previous block. Updated for the next block.
+ *
+ * @return The mask of bytes that follow an odd-length run of backslashes.
+ */
+AZ_NODISCARD AZ_INLINE uint64_t
+_az_simd_json_find_escaped(uint64_t backslash, uint64_t* ref_prev_escaped)
+{
+  uint64_t const even_bits = 0x5555555555555555ULL;
+
+  // A backslash that is itself escaped doesn't start a new escape sequence.
+  backslash &= ~*ref_prev_escaped;
+
+  uint64_t const follows_escape = (backslash << 1U) | *ref_prev_escaped;
+  uint64_t const odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+
+  // Adding the start of each run to the run makes the carry ripple to the bit just after it. The
+  // parity of the position where the run started tells us which of the bits after it are escaped.
+  uint64_t const sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+  *ref_prev_escaped = sequences_starting_on_even_bits < odd_sequence_starts ? 1U : 0U;
+
+  uint64_t const invert_mask = sequences_starting_on_even_bits << 1U;
+  return (even_bits ^ invert_mask) & follows_escape;
+}
+
+/**
+ * @brief Bit masks describing the nesting within a block of #_az_SIMD_JSON_BLOCK_SIZE bytes of JSON
+ * text. Bit `i` of each mask corresponds to byte `i` of the block.
+ */
+typedef struct
+{
+  uint64_t quote; ///< The byte is a `"`.
+  uint64_t backslash; ///< The byte is a `\`.
+  uint64_t open; ///< The byte is a `{` or a `[`.
+  uint64_t close; ///< The byte is a `}` or a `]`.
+  uint64_t comma; ///< The byte is a `,`.
+} _az_simd_json_nesting_masks;
+
+/**
+ * @brief Returns the number of set bits within \p value.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_simd_count_set_bits(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (int32_t)__builtin_popcountll(value);
+#else
+  value = value - ((value >> 1U) & 0x5555555555555555ULL);
+  value = (value & 0x3333333333333333ULL) + ((value >> 2U) & 0x3333333333333333ULL);
+  value = (value + (value >> 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((value * 0x0101010101010101ULL) >> 56U);
+#endif
+}
+
+/**
+ * @brief Finds the quotes, backslashes, commas, and the starts and ends of objects and arrays,
+ * within the #_az_SIMD_JSON_BLOCK_SIZE bytes starting at \p block.
+ *
+ * @param[in] block A pointer to at least #_az_SIMD_JSON_BLOCK_SIZE readable bytes.
+ * @param[out] out_masks The masks describing each byte of the block.
+ */
+AZ_INLINE void _az_simd_json_classify_nesting_block(
+    uint8_t const* block,
+    _az_simd_json_nesting_masks* out_masks)
+{
+  *out_masks = (_az_simd_json_nesting_masks){ 0 };
+
+#ifdef _az_SIMD_SSE2
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const lowercase = _mm_set1_epi8(0x20);
+  __m128i const open_brace = _mm_set1_epi8('{');
+  __m128i const close_brace = _mm_set1_epi8('}');
+  __m128i const comma = _mm_set1_epi8(',');
+
+  for (int32_t i = 0; i < _az_SIMD_JSON_BLOCK_SIZE; i += 16)
+  {
+    __m128i const bytes = _mm_loadu_si128((__m128i const*)(void const*)(block + i));
+
+    // '[' and ']' only differ from '{' and '}' by the 0x20 bit, and no other byte is either of
+    // them once that bit is set.
+    __m128i const folded = _mm_or_si128(bytes, lowercase);
+
+    uint32_t const shift = (uint32_t)i;
+    out_masks->quote |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote))
+        << shift;
+    out_masks->backslash |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslash))
+        << shift;
+    out_masks->open |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(folded, open_brace))
+        << shift;
+    out_masks->close |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(folded, close_brace))
+        << shift;
+    out_masks->comma |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma))
+        << shift;
+  }
+#else
+  for (int32_t i = 0; i < _az_SIMD_JSON_BLOCK_SIZE; i++)
+  {
+    uint64_t const bit = 1ULL << (uint32_t)i;
+    switch (block[i])
+    {
+      case '"':
+        out_masks->quote |= bit;
+        break;
+      case '\\':
+        out_masks->backslash |= bit;
+        break;
+      case '{':
+      case '[':
+        out_masks->open |= bit;
+        break;
+      case '}':
+      case ']':
+        out_masks->close |= bit;
+        break;
+      case ',':
+        out_masks->comma |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+#endif // _az_SIMD_SSE2
+}
+
+// Returns true if any byte of the 8 bytes in \p value is zero.
+#define _az_SIMD_HAS_ZERO_BYTE(value) \
+  ((((value)-0x0101010101010101ULL) & ~(value)&0x8080808080808080ULL) != 0)
+
+// Returns true if any byte of the 8 bytes in \p value is less than 0x20.
+#define _az_SIMD_HAS_CONTROL_BYTE(value) \
+  ((((value)-0x2020202020202020ULL) & ~(value)&0x8080808080808080ULL) != 0)
+
+/**
+ * @brief Returns true if any of the 8 bytes starting at \p bytes is a `"`, a `\`, or a control
+ * character, which are the bytes that need special handling within a JSON string.
+ */
+AZ_NODISCARD AZ_INLINE bool _az_simd_json_has_string_special_byte(uint8_t const* bytes)
+{
+  uint64_t value = 0;
+  memcpy(&value, bytes, sizeof(value));
+
+  uint64_t const quotes = value ^ 0x2222222222222222ULL;
+  uint64_t const backslashes = value ^ 0x5C5C5C5C5C5C5C5CULL;
+
+  return _az_SIMD_HAS_ZERO_BYTE(quotes) || _az_SIMD_HAS_ZERO_BYTE(backslashes)
+      || _az_SIMD_HAS_CONTROL_BYTE(value);
+}
+
+/**
+ * @brief Returns the number of bytes, from the start of \p bytes, before the first `"`, `\`, or
+ * control character, or \p size if there are none.
+ *
+ * @details Checks 16 bytes at a time, using SSE2 where it is available, or two 8 byte words
+ * otherwise.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+_az_simd_json_count_plain_string_bytes(uint8_t const* bytes, int32_t size)
+{
+  int32_t i = 0;
+
+#ifdef _az_SIMD_SSE2
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const last_control = _mm_set1_epi8(0x1F);
+
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const chunk = _mm_loadu_si128((__m128i const*)(void const*)(bytes + i));
+    __m128i const special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, last_control), last_control));
+
+    int const mask = _mm_movemask_epi8(special);
+    if (mask != 0)
+    {
+      return i + _az_simd_count_trailing_zeros((uint64_t)(uint32_t)mask);
+    }
+  }
+#else
+  for (; i + 16 <= size; i += 16)
+  {
+    if (_az_simd_json_has_string_special_byte(bytes + i)
+        || _az_simd_json_has_string_special_byte(bytes + i + 8))
+    {
+      break;
+    }
+  }
+#endif // _az_SIMD_SSE2
+
+  for (; i + 8 <= size; i += 8)
+  {
+    if (_az_simd_json_has_string_special_byte(bytes + i))
+    {
+      break;
+    }
+  }
+
+  for (; i < size; i++)
+  {
+    uint8_t const byte = bytes[i];
+    if (byte == '"' || byte == '\\' || byte < 0x20)
+    {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/**
+ * @brief Returns the number of bytes, from the start of \p bytes, before the first one which isn't
+ * ASCII, or \p size if there are none.
+ *
+ * @details Checks 16 bytes at a time using SSE2 where it is available, and 8 byte words otherwise.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_simd_count_ascii_bytes(uint8_t const* bytes, int32_t size)
+{
+  int32_t i = 0;
+
+#ifdef _az_SIMD_SSE2
+  for (; i + 16 <= size; i += 16)
+  {
+    // The most significant bit of every byte is only set for bytes which aren't ASCII.
+    __m128i const chunk = _mm_loadu_si128((__m128i const*)(void const*)(bytes + i));
+    int const mask = _mm_movemask_epi8(chunk);
+    if (mask != 0)
+    {
+      return i + _az_simd_count_trailing_zeros((uint64_t)(uint32_t)mask);
+    }
+  }
+#endif // _az_SIMD_SSE2
+
+  for (; i + 8 <= size; i += 8)
+  {
+    uint64_t word = 0;
+    memcpy(&word, bytes + i, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0)
+    {
+      break;
+    }
+  }
+
+  for (; i < size; i++)
+  {
+    if (bytes[i] >= 0x80)
+    {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/**
+ * @brief Returns the number of bytes, from the start of \p bytes, before the first one equal to
+ * \p value, or \p size if there are none.
+ *
+ * @details Checks 16 bytes at a time using SSE2 where it is available, and 8 byte words otherwise.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+_az_simd_count_bytes_before(uint8_t const* bytes, int32_t size, uint8_t value)
+{
+  int32_t i = 0;
+
+#ifdef _az_SIMD_SSE2
+  __m128i const expected = _mm_set1_epi8((char)value);
+
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const chunk = _mm_loadu_si128((__m128i const*)(void const*)(bytes + i));
+    int const mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, expected));
+    if (mask != 0)
+    {
+      return i + _az_simd_count_trailing_zeros((uint64_t)(uint32_t)mask);
+    }
+  }
+#endif // _az_SIMD_SSE2
+
+  uint64_t const repeated = 0x0101010101010101ULL * value;
+  for (; i + 8 <= size; i += 8)
+  {
+    uint64_t word = 0;
+    memcpy(&word, bytes + i, sizeof(word));
+    word ^= repeated;
+    if (_az_SIMD_HAS_ZERO_BYTE(word))
+    {
+      break;
+    }
+  }
+
+  for (; i < size; i++)
+  {
+    if (bytes[i] == value)
+    {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/**
+ * @brief Loads the 8 bytes starting at \p bytes into a uint64_t, the first byte being the least
+ * significant one, whatever the byte order of the target.
+ */
+AZ_NODISCARD AZ_INLINE uint64_t _az_simd_load_little_endian_u64(uint8_t const* bytes)
+{
+  return (uint64_t)bytes[0] | ((uint64_t)bytes[1] << 8U) | ((uint64_t)bytes[2] << 16U)
+      | ((uint64_t)bytes[3] << 24U) | ((uint64_t)bytes[4] << 32U) | ((uint64_t)bytes[5] << 40U)
+      | ((uint64_t)bytes[6] << 48U) | ((uint64_t)bytes[7] << 56U);
+}
+
+/**
+ * @brief Returns true if all 8 bytes of \p value, as loaded by #_az_simd_load_little_endian_u64,
+ * are ASCII digits.
+ */
+AZ_NODISCARD AZ_INLINE bool _az_simd_is_eight_digits(uint64_t value)
+{
+  // The high nibble of every byte must be 3, and adding 6 to the low nibble must not carry into it.
+  return (((value & 0xF0F0F0F0F0F0F0F0ULL)
+           | (((value + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4U))
+          == 0x3333333333333333ULL);
+}
+
+/**
+ * @brief Converts 8 ASCII digits, as loaded by #_az_simd_load_little_endian_u64, to their value,
+ * using three multiplications instead of one per digit.
+ */
+AZ_NODISCARD AZ_INLINE uint32_t _az_simd_parse_eight_digits(uint64_t value)
+{
+  uint64_t const mask = 0x000000FF000000FFULL;
+  uint64_t const multiplier_1 = 100 + (1000000ULL << 32U);
+  uint64_t const multiplier_2 = 1 + (10000ULL << 32U);
+
+  value -= 0x3030303030303030ULL;
+
+  // Combine neighboring digits into pairs, then pairs into groups of four, then both groups.
+  value = (value * 10) + (value >> 8U);
+  value = (((value & mask) * multiplier_1) + (((value >> 16U) & mask) * multiplier_2)) >> 32U;
+  return (uint32_t)value;
+}
+
+#include <azure/core/_az_cfg_suffix.h>
+
+#endif // _az_SIMD_PRIVATE_H
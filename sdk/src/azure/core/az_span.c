@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "az_hex_private.h"
+#include "az_simd_private.h"
 #include "az_span_private.h"
 #include <azure/core/az_precondition.h>
 #include <azure/core/az_span.h>
@@ -13,14 +14,9 @@
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include <stdio.h>
 
 #include <azure/core/_az_cfg.h>
 
-// The maximum integer value that can be stored in a double without losing precision (2^53 - 1)
-// An IEEE 64-bit double has 52 bits of mantissa
-#define _az_MAX_SAFE_INTEGER 9007199254740991
-
 #ifndef AZ_NO_PRECONDITION_CHECKING
 // Note: If you are modifying this function, make sure to modify the inline version in the az_span.h
 // file as well.
@@ -100,11 +96,16 @@ AZ_NODISCARD bool az_span_is_content_equal_ignoring_case(az_span span1, az_span
   return true;
 }
 
-AZ_NODISCARD az_result az_span_atou64(az_span source, uint64_t* out_number)
+// Parses an optionally signed number from \p source, no larger in magnitude than \p max_value, or
+// than \p max_value + 1 if it is negative, converting its digits 8 at a time where possible. A
+// minus sign is only accepted when \p allow_negative is true.
+static AZ_NODISCARD az_result _az_span_parse_integer(
+    az_span source,
+    uint64_t max_value,
+    bool allow_negative,
+    uint64_t* out_magnitude,
+    bool* out_is_negative)
 {
-  _az_PRECONDITION_VALID_SPAN(source, 1, false);
-  _az_PRECONDITION_NOT_NULL(out_number);
-
   int32_t const span_size = az_span_size(source);
 
   if (span_size < 1)
@@ -112,89 +113,97 @@ AZ_NODISCARD az_result az_span_atou64(az_span source, uint64_t* out_number)
     return AZ_ERROR_UNEXPECTED_CHAR;
   }
 
-  // If the first character is not a digit or an optional + sign, return error.
-  int32_t starting_index = 0;
-  uint8_t* source_ptr = az_span_ptr(source);
-  uint8_t next_byte = source_ptr[0];
+  // If the first character is not a digit, an optional + sign, or - sign when allowed, return
+  // error.
+  uint8_t const* digits = az_span_ptr(source);
+  uint8_t const first_byte = digits[0];
+  *out_is_negative = false;
 
-  if (!isdigit(next_byte))
+  // Comparing the range directly is faster than isdigit(), which depends on the current locale.
+  if (first_byte < '0' || first_byte > '9')
   {
+    if (first_byte == '-' && allow_negative)
+    {
+      // The absolute value of INT64_MIN (or INT32_MIN) is 1 more than the absolute value of
+      // INT64_MAX (or INT32_MAX).
+      *out_is_negative = true;
+      max_value++;
+    }
+    else if (first_byte != '+')
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
     // There must be another byte after a sign.
-    // The loop below checks that it must be a digit.
-    if (next_byte != '+' || span_size < 2)
+    // The code below checks that it must be a digit.
+    if (span_size < 2)
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
-    starting_index++;
+    digits++;
   }
 
-  uint64_t value = 0;
+  uint8_t const* const end = az_span_ptr(source) + span_size;
 
-  for (int32_t i = starting_index; i < span_size; ++i)
+  // Leading zeros don't change the value, and once they are skipped, any number which fits within
+  // a uint64_t has at most 20 digits.
+  if (*digits == '0')
   {
-    next_byte = source_ptr[i];
-    if (!isdigit(next_byte))
+    while (end - digits >= 8 && _az_simd_load_little_endian_u64(digits) == 0x3030303030303030ULL)
     {
-      return AZ_ERROR_UNEXPECTED_CHAR;
+      digits += 8;
     }
-    uint64_t const d = (uint64_t)next_byte - '0';
-
-    // Check whether the next digit will cause an integer overflow.
-    // Before actually doing the math below, this is checking whether value * 10 + d > UINT64_MAX.
-    if ((UINT64_MAX - d) / _az_NUMBER_OF_DECIMAL_VALUES < value)
+    while (digits < end && *digits == '0')
     {
-      return AZ_ERROR_UNEXPECTED_CHAR;
+      digits++;
     }
-
-    value = value * _az_NUMBER_OF_DECIMAL_VALUES + d;
   }
 
-  *out_number = value;
-  return AZ_OK;
-}
-
-AZ_NODISCARD az_result az_span_atou32(az_span source, uint32_t* out_number)
-{
-  _az_PRECONDITION_VALID_SPAN(source, 1, false);
-  _az_PRECONDITION_NOT_NULL(out_number);
-
-  int32_t const span_size = az_span_size(source);
-
-  if (span_size < 1)
+  if (end - digits > _az_MAX_SIZE_FOR_UINT64)
   {
     return AZ_ERROR_UNEXPECTED_CHAR;
   }
 
-  // If the first character is not a digit or an optional + sign, return error.
-  int32_t starting_index = 0;
-  uint8_t* source_ptr = az_span_ptr(source);
-  uint8_t next_byte = source_ptr[0];
+  // Numbers with up to 19 digits can't overflow a uint64_t, so only a 20th digit needs an overflow
+  // check.
+  uint8_t const* const unchecked_end
+      = end - digits < _az_MAX_SIZE_FOR_UINT64 ? end : end - 1;
 
-  if (!isdigit(next_byte))
+  uint64_t value = 0;
+  while (unchecked_end - digits >= 8)
   {
-    // There must be another byte after a sign.
-    // The loop below checks that it must be a digit.
-    if (next_byte != '+' || span_size < 2)
+    uint64_t const eight_digits = _az_simd_load_little_endian_u64(digits);
+    if (!_az_simd_is_eight_digits(eight_digits))
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
-    starting_index++;
+
+    value = value * 100000000U + _az_simd_parse_eight_digits(eight_digits);
+    digits += 8;
   }
 
-  uint32_t value = 0;
+  for (; digits < unchecked_end; digits++)
+  {
+    uint32_t const d = (uint32_t)*digits - '0';
+    if (d >= _az_NUMBER_OF_DECIMAL_VALUES)
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
 
-  for (int32_t i = starting_index; i < span_size; ++i)
+    value = value * _az_NUMBER_OF_DECIMAL_VALUES + d;
+  }
+
+  if (digits < end)
   {
-    next_byte = source_ptr[i];
-    if (!isdigit(next_byte))
+    uint64_t const d = (uint64_t)*digits - '0';
+    if (d >= _az_NUMBER_OF_DECIMAL_VALUES)
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
-    uint32_t const d = (uint32_t)next_byte - '0';
 
-    // Check whether the next digit will cause an integer overflow.
-    // Before actually doing the math below, this is checking whether value * 10 + d > UINT32_MAX.
-    if ((UINT32_MAX - d) / _az_NUMBER_OF_DECIMAL_VALUES < value)
+    // Check whether the last digit will cause an integer overflow.
+    // Before actually doing the math below, this is checking whether value * 10 + d > UINT64_MAX.
+    if ((UINT64_MAX - d) / _az_NUMBER_OF_DECIMAL_VALUES < value)
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
@@ -202,77 +211,52 @@ AZ_NODISCARD az_result az_span_atou32(az_span source, uint32_t* out_number)
     value = value * _az_NUMBER_OF_DECIMAL_VALUES + d;
   }
 
-  *out_number = value;
+  if (value > max_value)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  *out_magnitude = value;
   return AZ_OK;
 }
 
-AZ_NODISCARD az_result az_span_atoi64(az_span source, int64_t* out_number)
+AZ_NODISCARD az_result az_span_atou64(az_span source, uint64_t* out_number)
 {
   _az_PRECONDITION_VALID_SPAN(source, 1, false);
   _az_PRECONDITION_NOT_NULL(out_number);
 
-  int32_t const span_size = az_span_size(source);
-
-  if (span_size < 1)
-  {
-    return AZ_ERROR_UNEXPECTED_CHAR;
-  }
-
-  // If the first character is not a digit, - sign, or an optional + sign, return error.
-  int32_t starting_index = 0;
-  uint8_t* source_ptr = az_span_ptr(source);
-  uint8_t next_byte = source_ptr[0];
-  int64_t sign = 1;
+  uint64_t value = 0;
+  bool is_negative = false;
+  _az_RETURN_IF_FAILED(_az_span_parse_integer(source, UINT64_MAX, false, &value, &is_negative));
 
-  if (!isdigit(next_byte))
-  {
-    // There must be another byte after a sign.
-    // The loop below checks that it must be a digit.
-    if (next_byte != '+')
-    {
-      if (next_byte != '-')
-      {
-        return AZ_ERROR_UNEXPECTED_CHAR;
-      }
-      sign = -1;
-    }
-    if (span_size < 2)
-    {
-      return AZ_ERROR_UNEXPECTED_CHAR;
-    }
-    starting_index++;
-  }
+  *out_number = value;
+  return AZ_OK;
+}
 
-  // if sign < 0, (-1 * sign + 1) / 2 = 1
-  // else, (-1 * sign + 1) / 2 = 0
-  // This is necessary to correctly account for the fact that the absolute value of INT64_MIN is 1
-  // more than than the absolute value of INT64_MAX.
-  uint64_t sign_factor = (uint64_t)(-1 * sign + 1) / 2;
+AZ_NODISCARD az_result az_span_atou32(az_span source, uint32_t* out_number)
+{
+  _az_PRECONDITION_VALID_SPAN(source, 1, false);
+  _az_PRECONDITION_NOT_NULL(out_number);
 
-  // Using unsigned int while parsing to account for potential overflow.
   uint64_t value = 0;
+  bool is_negative = false;
+  _az_RETURN_IF_FAILED(_az_span_parse_integer(source, UINT32_MAX, false, &value, &is_negative));
 
-  for (int32_t i = starting_index; i < span_size; ++i)
-  {
-    next_byte = source_ptr[i];
-    if (!isdigit(next_byte))
-    {
-      return AZ_ERROR_UNEXPECTED_CHAR;
-    }
-    uint64_t const d = (uint64_t)next_byte - '0';
+  *out_number = (uint32_t)value;
+  return AZ_OK;
+}
 
-    // Check whether the next digit will cause an integer overflow.
-    // Before actually doing the math below, this is checking whether value * 10 + d > INT64_MAX, or
-    // in the case of negative numbers, checking whether value * 10 + d > INT64_MAX + 1.
-    if ((uint64_t)(INT64_MAX - d + sign_factor) / _az_NUMBER_OF_DECIMAL_VALUES < value)
-    {
-      return AZ_ERROR_UNEXPECTED_CHAR;
-    }
+AZ_NODISCARD az_result az_span_atoi64(az_span source, int64_t* out_number)
+{
+  _az_PRECONDITION_VALID_SPAN(source, 1, false);
+  _az_PRECONDITION_NOT_NULL(out_number);
 
-    value = value * _az_NUMBER_OF_DECIMAL_VALUES + d;
-  }
+  uint64_t value = 0;
+  bool is_negative = false;
+  _az_RETURN_IF_FAILED(_az_span_parse_integer(source, INT64_MAX, true, &value, &is_negative));
 
-  *out_number = (int64_t)value * sign;
+  // Negating value - 1 avoids overflowing when the number is INT64_MIN.
+  *out_number = is_negative ? -(int64_t)(value - 1) - 1 : (int64_t)value;
   return AZ_OK;
 }
 
@@ -281,68 +265,12 @@ AZ_NODISCARD az_result az_span_atoi32(az_span source, int32_t* out_number)
   _az_PRECONDITION_VALID_SPAN(source, 1, false);
   _az_PRECONDITION_NOT_NULL(out_number);
 
-  int32_t const span_size = az_span_size(source);
-
-  if (span_size < 1)
-  {
-    return AZ_ERROR_UNEXPECTED_CHAR;
-  }
-
-  // If the first character is not a digit, - sign, or an optional + sign, return error.
-  int32_t starting_index = 0;
-  uint8_t* source_ptr = az_span_ptr(source);
-  uint8_t next_byte = source_ptr[0];
-  int32_t sign = 1;
-
-  if (!isdigit(next_byte))
-  {
-    // There must be another byte after a sign.
-    // The loop below checks that it must be a digit.
-    if (next_byte != '+')
-    {
-      if (next_byte != '-')
-      {
-        return AZ_ERROR_UNEXPECTED_CHAR;
-      }
-      sign = -1;
-    }
-    if (span_size < 2)
-    {
-      return AZ_ERROR_UNEXPECTED_CHAR;
-    }
-    starting_index++;
-  }
-
-  // if sign < 0, (-1 * sign + 1) / 2 = 1
-  // else, (-1 * sign + 1) / 2 = 0
-  // This is necessary to correctly account for the fact that the absolute value of INT32_MIN is 1
-  // more than than the absolute value of INT32_MAX.
-  uint32_t sign_factor = (uint32_t)(-1 * sign + 1) / 2;
-
-  // Using unsigned int while parsing to account for potential overflow.
-  uint32_t value = 0;
-
-  for (int32_t i = starting_index; i < span_size; ++i)
-  {
-    next_byte = source_ptr[i];
-    if (!isdigit(next_byte))
-    {
-      return AZ_ERROR_UNEXPECTED_CHAR;
-    }
-    uint32_t const d = (uint32_t)next_byte - '0';
-
-    // Check whether the next digit will cause an integer overflow.
-    // Before actually doing the math below, this is checking whether value * 10 + d > INT32_MAX, or
-    // in the case of negative numbers, checking whether value * 10 + d > INT32_MAX + 1.
-    if ((uint32_t)(INT32_MAX - d + sign_factor) / _az_NUMBER_OF_DECIMAL_VALUES < value)
-    {
-      return AZ_ERROR_UNEXPECTED_CHAR;
-    }
-
-    value = value * _az_NUMBER_OF_DECIMAL_VALUES + d;
-  }
+  uint64_t value = 0;
+  bool is_negative = false;
+  _az_RETURN_IF_FAILED(_az_span_parse_integer(source, INT32_MAX, true, &value, &is_negative));
 
-  *out_number = (int32_t)value * sign;
+  // Negating value - 1 avoids overflowing when the number is INT32_MIN.
+  *out_number = is_negative ? -(int32_t)(value - 1) - 1 : (int32_t)value;
   return AZ_OK;
 }
 
@@ -354,15 +282,6 @@ static bool _is_valid_start_of_double(uint8_t first_byte)
   return result;
 }
 
-// Disable the following warning just for this particular use case.
-// C4996: 'sscanf': This function or variable may be unsafe. Consider using sscanf_s instead.
-// C4710: 'sscanf': function not inlined
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#pragma warning(disable : 4710)
-#endif
-
 AZ_NODISCARD az_result az_span_atod(az_span source, double* out_number)
 {
   _az_PRECONDITION_VALID_SPAN(source, 1, false);
@@ -372,36 +291,15 @@ AZ_NODISCARD az_result az_span_atod(az_span source, double* out_number)
 
   _az_PRECONDITION_RANGE(1, size, _az_MAX_SIZE_FOR_PARSING_DOUBLE);
 
-  // This check is necessary to prevent sscanf from reading bytes past the end of the span, when the
-  // span might contain whitespace or other invalid bytes at the start.
   uint8_t* source_ptr = az_span_ptr(source);
   if (size < 1 || !_is_valid_start_of_double(source_ptr[0]))
   {
     return AZ_ERROR_UNEXPECTED_CHAR;
   }
 
-  // Stack based string to allow thread-safe mutation.
-  // The length is 8 to allow space for the null-terminating character.
-  // NOLINTNEXTLINE(readability-magic-numbers,  cppcoreguidelines-avoid-magic-numbers)
-  char format[8] = "%00lf%n";
-
-  // Starting at 1 to skip the '%' character
-  format[1] = (char)((size / _az_NUMBER_OF_DECIMAL_VALUES) + '0');
-  format[2] = (char)((size % _az_NUMBER_OF_DECIMAL_VALUES) + '0');
-
-  int32_t chars_consumed = 0;
-  // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
-  int32_t n = sscanf((char*)source_ptr, format, out_number, &chars_consumed);
-
-  // Success if the entire source was consumed by sscanf and it set the out_number argument.
-  return (size == chars_consumed && n == 1 && _az_isfinite(*out_number)) ? AZ_OK
-                                                                         : AZ_ERROR_UNEXPECTED_CHAR;
+  return _az_span_segments_atod(_az_span_segments_create(&source, 0, 0, 0, size), out_number);
 }
 
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
-
 AZ_NODISCARD int32_t az_span_find(az_span source, az_span target)
 {
   /* This function implements the Naive string-search algorithm.
@@ -558,41 +456,130 @@ void az_span_to_str(char* destination, int32_t destination_max_size, az_span sou
   destination[size_to_write] = 0;
 }
 
-AZ_INLINE uint8_t _az_decimal_to_ascii(uint8_t d)
+// The two ASCII digits of every number from 0 to 99, so that the digits of a number can be written
+// two at a time.
+static uint8_t const _az_decimal_digit_pairs[200] = {
+  '0', '0', '0', '1', '0', '2', '0', '3', '0', '4',
+  '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+  '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',
+  '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+  '2', '0', '2', '1', '2', '2', '2', '3', '2', '4',
+  '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+  '3', '0', '3', '1', '3', '2', '3', '3', '3', '4',
+  '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+  '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+  '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+  '5', '0', '5', '1', '5', '2', '5', '3', '5', '4',
+  '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+  '6', '0', '6', '1', '6', '2', '6', '3', '6', '4',
+  '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+  '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',
+  '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+  '8', '0', '8', '1', '8', '2', '8', '3', '8', '4',
+  '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+  '9', '0', '9', '1', '9', '2', '9', '3', '9', '4',
+  '9', '5', '9', '6', '9', '7', '9', '8', '9', '9',
+};
+
+// 10^i, for every number of digits a uint64_t can have.
+static uint64_t const _az_powers_of_ten[_az_MAX_SIZE_FOR_UINT64] = {
+  1ULL,
+  10ULL,
+  100ULL,
+  1000ULL,
+  10000ULL,
+  100000ULL,
+  1000000ULL,
+  10000000ULL,
+  100000000ULL,
+  1000000000ULL,
+  10000000000ULL,
+  100000000000ULL,
+  1000000000000ULL,
+  10000000000000ULL,
+  100000000000000ULL,
+  1000000000000000ULL,
+  10000000000000000ULL,
+  100000000000000000ULL,
+  1000000000000000000ULL,
+  _az_SMALLEST_20_DIGIT_NUMBER,
+};
+
+AZ_NODISCARD int32_t _az_span_u64toa_size(uint64_t number)
 {
-  return (uint8_t)((uint32_t)('0' + d) & (uint8_t)UINT8_MAX);
+  // Zero has one digit, just like one.
+  number |= 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+  // floor(log10(number)) is either floor(log2(number) * log10(2)) or one more, and 1233 / 4096 is
+  // close enough to log10(2) for 64-bit numbers.
+  int32_t const bit_count = 64 - __builtin_clzll(number);
+  int32_t const digit_count = (bit_count * 1233) >> 12;
+  return digit_count + (number >= _az_powers_of_ten[digit_count] ? 1 : 0);
+#else
+  int32_t digit_count = 1;
+  while (digit_count < _az_MAX_SIZE_FOR_UINT64 && number >= _az_powers_of_ten[digit_count])
+  {
+    digit_count++;
+  }
+  return digit_count;
+#endif
 }
 
-static AZ_NODISCARD az_result _az_span_builder_append_uint64(az_span* ref_span, uint64_t n)
+// Writes the two digits of a number less than 100 at \p destination.
+AZ_INLINE void _az_span_write_digit_pair(uint8_t* destination, uint32_t pair)
+{
+  destination[0] = _az_decimal_digit_pairs[pair * 2];
+  destination[1] = _az_decimal_digit_pairs[pair * 2 + 1];
+}
+
+void _az_span_write_uint64_digits(uint8_t* destination, uint64_t number, int32_t digit_count)
 {
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_span, 1);
+  _az_PRECONDITION(digit_count == _az_span_u64toa_size(number));
 
-  if (n == 0)
+  uint8_t* end = destination + digit_count;
+
+  // 64-bit divisions are slow on 32-bit devices, so split off 8 digits at a time until the rest
+  // fits within 32 bits.
+  while (number > UINT32_MAX)
   {
-    *ref_span = az_span_copy_u8(*ref_span, '0');
-    return AZ_OK;
+    uint64_t const quotient = number / 100000000U;
+    uint32_t remainder = (uint32_t)(number - quotient * 100000000U);
+    number = quotient;
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+      end -= 2;
+      _az_span_write_digit_pair(end, remainder % 100);
+      remainder /= 100;
+    }
   }
 
-  uint64_t div = _az_SMALLEST_20_DIGIT_NUMBER;
-  uint64_t nn = n;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT64;
-  while (nn / div == 0)
+  uint32_t small_number = (uint32_t)number;
+  while (small_number >= 100)
   {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
+    end -= 2;
+    _az_span_write_digit_pair(end, small_number % 100);
+    small_number /= 100;
   }
 
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_span, digit_count);
-
-  while (div > 1)
+  if (small_number >= 10)
+  {
+    _az_span_write_digit_pair(end - 2, small_number);
+  }
+  else
   {
-    uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)(nn / div));
-    *ref_span = az_span_copy_u8(*ref_span, value_to_append);
-    nn %= div;
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
+    end[-1] = (uint8_t)('0' + small_number);
   }
-  uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)nn);
-  *ref_span = az_span_copy_u8(*ref_span, value_to_append);
+}
+
+static AZ_NODISCARD az_result _az_span_builder_append_uint64(az_span* ref_span, uint64_t n)
+{
+  int32_t const digit_count = _az_span_u64toa_size(n);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_span, digit_count);
+
+  _az_span_write_uint64_digits(az_span_ptr(*ref_span), n, digit_count);
+  *ref_span = az_span_slice_to_end(*ref_span, digit_count);
   return AZ_OK;
 }
 
@@ -614,7 +601,8 @@ AZ_NODISCARD az_result az_span_i64toa(az_span destination, int64_t source, az_sp
   {
     _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, 1);
     *out_span = az_span_copy_u8(destination, '-');
-    return _az_span_builder_append_uint64(out_span, (uint64_t)-source);
+    // Negate as unsigned, since -INT64_MIN doesn't fit within an int64_t.
+    return _az_span_builder_append_uint64(out_span, 0U - (uint64_t)source);
   }
 
   // make out_span point to destination before trying to write on it (might be an empty az_span or
@@ -626,38 +614,11 @@ AZ_NODISCARD az_result az_span_i64toa(az_span destination, int64_t source, az_sp
 static AZ_NODISCARD az_result
 _az_span_builder_append_u32toa(az_span destination, uint32_t n, az_span* out_span)
 {
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, 1);
-
-  if (n == 0)
-  {
-    *out_span = az_span_copy_u8(destination, '0');
-    return AZ_OK;
-  }
-
-  uint32_t div = _az_SMALLEST_10_DIGIT_NUMBER;
-  uint32_t nn = n;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT32;
-  while (nn / div == 0)
-  {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
-  }
-
+  int32_t const digit_count = _az_span_u32toa_size(n);
   _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, digit_count);
 
-  *out_span = destination;
-
-  while (div > 1)
-  {
-    uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)(nn / div));
-    *out_span = az_span_copy_u8(*out_span, value_to_append);
-
-    nn %= div;
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-  }
-
-  uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)nn);
-  *out_span = az_span_copy_u8(*out_span, value_to_append);
+  _az_span_write_uint64_digits(az_span_ptr(destination), n, digit_count);
+  *out_span = az_span_slice_to_end(destination, digit_count);
   return AZ_OK;
 }
 
@@ -679,7 +640,9 @@ AZ_NODISCARD az_result az_span_i32toa(az_span destination, int32_t source, az_sp
   {
     _az_RETURN_IF_NOT_ENOUGH_SIZE(*out_span, 1);
     *out_span = az_span_copy_u8(*out_span, '-');
-    source = -source;
+
+    // Negate as unsigned, since -INT32_MIN doesn't fit within an int32_t.
+    return _az_span_builder_append_u32toa(*out_span, 0U - (uint32_t)source, out_span);
   }
 
   return _az_span_builder_append_u32toa(*out_span, (uint32_t)source, out_span);
@@ -1004,3 +967,84 @@ az_span _az_span_token(
   *out_remainder = AZ_SPAN_EMPTY;
   return source;
 }
+
+AZ_NODISCARD bool _az_utf8_validate(_az_utf8_validator* ref_validator, az_span text)
+{
+  _az_PRECONDITION_NOT_NULL(ref_validator);
+
+  uint8_t const* const text_ptr = az_span_ptr(text);
+  int32_t const text_size = az_span_size(text);
+
+  int32_t i = 0;
+  while (i < text_size)
+  {
+    // Finish the multi-byte sequence started by an earlier byte, possibly within an earlier part.
+    if (ref_validator->continuation_bytes > 0)
+    {
+      uint8_t const continuation = text_ptr[i];
+      if (continuation < ref_validator->next_min || continuation > ref_validator->next_max)
+      {
+        return false;
+      }
+
+      ref_validator->continuation_bytes--;
+      ref_validator->next_min = 0x80;
+      ref_validator->next_max = 0xBF;
+      i++;
+      continue;
+    }
+
+    // Most text is ASCII, which is always valid, so skip over it many bytes at a time.
+    i += _az_simd_count_ascii_bytes(text_ptr + i, text_size - i);
+    if (i >= text_size)
+    {
+      break;
+    }
+
+    // The lead byte determines the length of the sequence, and for some of them, the range of the
+    // second byte is narrower, to reject overlong encodings, surrogates, and values past U+10FFFF.
+    uint8_t const lead = text_ptr[i];
+    ref_validator->next_min = 0x80;
+    ref_validator->next_max = 0xBF;
+    if (lead < 0xC2)
+    {
+      // A continuation byte without a lead byte, or an overlong encoding of an ASCII character.
+      return false;
+    }
+    else if (lead < 0xE0)
+    {
+      ref_validator->continuation_bytes = 1;
+    }
+    else if (lead < 0xF0)
+    {
+      ref_validator->continuation_bytes = 2;
+      if (lead == 0xE0)
+      {
+        ref_validator->next_min = 0xA0;
+      }
+      else if (lead == 0xED)
+      {
+        ref_validator->next_max = 0x9F;
+      }
+    }
+    else if (lead < 0xF5)
+    {
+      ref_validator->continuation_bytes = 3;
+      if (lead == 0xF0)
+      {
+        ref_validator->next_min = 0x90;
+      }
+      else if (lead == 0xF4)
+      {
+        ref_validator->next_max = 0x8F;
+      }
+    }
+    else
+    {
+      return false;
+    }
+    i++;
+  }
+
+  return true;
+}
@@ -0,0 +1,583 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file
+ *
+ * @brief Formatting of a `double` into the shortest decimal text that parses back to the same
+ * value, without depending on the C library (`sprintf`) or the current locale.
+ *
+ * @details Uses the Ryu algorithm (Ulf Adams, "Ryū: fast float-to-string conversion", PLDI 2018).
+ * To keep the footprint small on constrained devices, the 128-bit approximations of the powers of
+ * five are not stored as full tables, but computed from every 26th entry, a table of the small
+ * powers of five, and 2-bit corrections which make the result identical to the full tables.
+ */
+
+#include "az_span_private.h"
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+#include <azure/core/internal/az_span_internal.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <azure/core/_az_cfg.h>
+
+enum
+{
+  // The number of explicitly stored bits in the significand of a double.
+  _az_DOUBLE_MANTISSA_BITS = 52,
+
+  // The exponent bias of a double.
+  _az_DOUBLE_EXPONENT_BIAS = 1023,
+
+  // The biased exponent used by infinity and NaN.
+  _az_DOUBLE_INFINITE_POWER = 0x7FF,
+
+  // The number of bits kept in the approximations of 5^i and 2^k / 5^i.
+  _az_POWER_OF_FIVE_BITS = 125,
+
+  // The distance between the entries of the base tables, i.e. the number of entries of
+  // _az_small_powers_of_five.
+  _az_POWER_OF_FIVE_TABLE_SIZE = 26,
+
+  // The most significant digits a double ever needs to round-trip.
+  _az_MAX_SHORTEST_DOUBLE_DIGITS = 17,
+
+  // Numbers whose decimal point would be further than this from the first digit are written in
+  // exponent notation, as in JavaScript.
+  _az_MAX_DECIMAL_NOTATION_EXPONENT = 21,
+  _az_MIN_DECIMAL_NOTATION_EXPONENT = -6,
+};
+
+// 5^0 to 5^25, which all fit within a uint64_t.
+static uint64_t const _az_small_powers_of_five[_az_POWER_OF_FIVE_TABLE_SIZE] = {
+  1ULL,
+  5ULL,
+  25ULL,
+  125ULL,
+  625ULL,
+  3125ULL,
+  15625ULL,
+  78125ULL,
+  390625ULL,
+  1953125ULL,
+  9765625ULL,
+  48828125ULL,
+  244140625ULL,
+  1220703125ULL,
+  6103515625ULL,
+  30517578125ULL,
+  152587890625ULL,
+  762939453125ULL,
+  3814697265625ULL,
+  19073486328125ULL,
+  95367431640625ULL,
+  476837158203125ULL,
+  2384185791015625ULL,
+  11920928955078125ULL,
+  59604644775390625ULL,
+  298023223876953125ULL,
+};
+
+// The 125 most significant bits of 5^(26 * i), as { low, high } pairs.
+static uint64_t const _az_powers_of_five_base[13][2] = {
+  { 0x0000000000000000ULL, 0x1000000000000000ULL },
+  { 0x0000000000000000ULL, 0x14ADF4B7320334B9ULL },
+  { 0x0E549208B31ADB10ULL, 0x1ABA4714957D300DULL },
+  { 0x6DC6AD264D8F0866ULL, 0x1145B7E285BF98F5ULL },
+  { 0xEB1DBD923D8596CAULL, 0x1652EFDC6018A1FCULL },
+  { 0xB4C1B80B22AE923CULL, 0x1CDA62055B2D9D83ULL },
+  { 0x5BB28B4E8F7E4C30ULL, 0x12A5568B9F52F416ULL },
+  { 0xF08AED437682D4FBULL, 0x1819651531F9E78FULL },
+  { 0xB4EE134AD99BF150ULL, 0x1F25C186A6F04C28ULL },
+  { 0x16499ECB70C25F03ULL, 0x1420EB449C8842E6ULL },
+  { 0x85A56EAD360865B0ULL, 0x1A03FDE214CAF085ULL },
+  { 0x093DB1D57999890BULL, 0x10CFEB353A97DAD8ULL },
+  { 0xCF38BB735E3F36ACULL, 0x15BAAF44FA52673EULL },
+};
+
+// floor(2^(floor(log2(5^i)) + 125) / 5^i) + 1 for i = 26 * index, as { low, high } pairs.
+static uint64_t const _az_inverse_powers_of_five_base[15][2] = {
+  { 0x0000000000000001ULL, 0x2000000000000000ULL },
+  { 0x52A6C95FC0655034ULL, 0x18C240C4AECB13BBULL },
+  { 0x7CA8D50071DFC806ULL, 0x1327FC58DA0F6FF5ULL },
+  { 0x6520247D3556476EULL, 0x1DA48CE468E7C702ULL },
+  { 0x6139CDD76802E6E9ULL, 0x16EF5B40C2FC7779ULL },
+  { 0xF951A7FF43DE8C79ULL, 0x11BEBDF578B2F391ULL },
+  { 0x7BE8BEE8D6E957E8ULL, 0x1B758D848FAC54B0ULL },
+  { 0x8BD3F9E999A423EAULL, 0x153EDA614071A3B7ULL },
+  { 0x0848F973CB3EE3CEULL, 0x10701BD527B4978CULL },
+  { 0x153285EBB9EFBFA2ULL, 0x196FBB9BB44DB44DULL },
+  { 0xADEEE7F86C07B696ULL, 0x13AE3591F5B4D936ULL },
+  { 0x4D686A4EAF182222ULL, 0x1E74404F3DAADA91ULL },
+  { 0x98C0A106E09EBD9FULL, 0x17900EA4FDA7C257ULL },
+  { 0x8F20E37371497D0EULL, 0x123B140576D820B2ULL },
+  { 0xB043138134743D85ULL, 0x1C35F4275F7A29ADULL },
+};
+
+// The correction (between 0 and 3) added to the computed approximation of 5^i, 2 bits per i.
+static uint32_t const _az_powers_of_five_offsets[21] = {
+  0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x40000000U, 0x59695995U, 0x55545555U,
+  0x56555515U, 0x41150504U, 0x40555410U, 0x44555145U, 0x44504540U, 0x45555550U, 0x40004000U,
+  0x96440440U, 0x55565565U, 0x54454045U, 0x40154151U, 0x55559155U, 0x51405555U, 0x00000105U,
+};
+
+// The correction (between 0 and 3) added to the computed approximation of 1 / 5^i, 2 bits per i.
+static uint32_t const _az_inverse_powers_of_five_offsets[22] = {
+  0x54544554U, 0x04055545U, 0x10041000U, 0x00400414U, 0x40010000U, 0x41155555U,
+  0x00000454U, 0x00010044U, 0x40000000U, 0x44000041U, 0x50454450U, 0x55550054U,
+  0x51655554U, 0x40004000U, 0x01000001U, 0x00010500U, 0x51515411U, 0x05555554U,
+  0x50411500U, 0x40040000U, 0x05040110U, 0x00000000U,
+};
+
+/**
+ * @brief A decimal number, `digits * 10^exponent`.
+ */
+typedef struct
+{
+  uint64_t digits;
+  int32_t exponent;
+} _az_decimal_number;
+
+// Returns ceil(log2(5^e)) for 0 < e <= 3528, and 1 for e == 0.
+AZ_NODISCARD AZ_INLINE int32_t _az_power_of_five_bits(int32_t e)
+{
+  return (int32_t)(((uint32_t)e * 1217359U) >> 19U) + 1;
+}
+
+// Returns floor(log10(2^e)) for 0 <= e <= 1650.
+AZ_NODISCARD AZ_INLINE int32_t _az_log10_of_power_of_two(int32_t e)
+{
+  return (int32_t)(((uint32_t)e * 78913U) >> 18U);
+}
+
+// Returns floor(log10(5^e)) for 0 <= e <= 2620.
+AZ_NODISCARD AZ_INLINE int32_t _az_log10_of_power_of_five(int32_t e)
+{
+  return (int32_t)(((uint32_t)e * 732923U) >> 20U);
+}
+
+// Returns the bits of the 128-bit value high:low from bit \p shift, for 0 < shift < 64.
+AZ_NODISCARD AZ_INLINE uint64_t _az_shift_right_128(uint64_t low, uint64_t high, int32_t shift)
+{
+  return (high << (uint32_t)(64 - shift)) | (low >> (uint32_t)shift);
+}
+
+// Computes the 125 most significant bits of 5^i, the same way as Ryu's full table.
+static void _az_compute_power_of_five(int32_t i, uint64_t result[2])
+{
+  int32_t const base = i / _az_POWER_OF_FIVE_TABLE_SIZE;
+  int32_t const base_power = base * _az_POWER_OF_FIVE_TABLE_SIZE;
+  int32_t const offset = i - base_power;
+  uint64_t const* const multiplier = _az_powers_of_five_base[base];
+
+  if (offset == 0)
+  {
+    result[0] = multiplier[0];
+    result[1] = multiplier[1];
+    return;
+  }
+
+  uint64_t const small_power = _az_small_powers_of_five[offset];
+  _az_uint128 const high_product = _az_multiply_64x64(small_power, multiplier[1]);
+  _az_uint128 const low_product = _az_multiply_64x64(small_power, multiplier[0]);
+
+  uint64_t const middle = low_product.high + high_product.low;
+  uint64_t const high = high_product.high + (middle < low_product.high ? 1U : 0U);
+
+  int32_t const shift = _az_power_of_five_bits(i) - _az_power_of_five_bits(base_power);
+  uint32_t const correction
+      = (_az_powers_of_five_offsets[i / 16] >> (((uint32_t)i % 16U) << 1U)) & 3U;
+
+  result[0] = _az_shift_right_128(low_product.low, middle, shift) + correction;
+  result[1] = _az_shift_right_128(middle, high, shift);
+}
+
+// Computes the approximation of 2^(floor(log2(5^i)) + 125) / 5^i, the same way as Ryu's full table.
+static void _az_compute_inverse_power_of_five(int32_t i, uint64_t result[2])
+{
+  int32_t const base = (i + _az_POWER_OF_FIVE_TABLE_SIZE - 1) / _az_POWER_OF_FIVE_TABLE_SIZE;
+  int32_t const base_power = base * _az_POWER_OF_FIVE_TABLE_SIZE;
+  int32_t const offset = base_power - i;
+  uint64_t const* const multiplier = _az_inverse_powers_of_five_base[base];
+
+  if (offset == 0)
+  {
+    result[0] = multiplier[0];
+    result[1] = multiplier[1];
+    return;
+  }
+
+  uint64_t const small_power = _az_small_powers_of_five[offset];
+  _az_uint128 const high_product = _az_multiply_64x64(small_power, multiplier[1]);
+  _az_uint128 const low_product = _az_multiply_64x64(small_power, multiplier[0] - 1);
+
+  uint64_t const middle = low_product.high + high_product.low;
+  uint64_t const high = high_product.high + (middle < low_product.high ? 1U : 0U);
+
+  int32_t const shift = _az_power_of_five_bits(base_power) - _az_power_of_five_bits(i);
+  uint32_t const correction
+      = (_az_inverse_powers_of_five_offsets[i / 16] >> (((uint32_t)i % 16U) << 1U)) & 3U;
+
+  result[0] = _az_shift_right_128(low_product.low, middle, shift) + 1 + correction;
+  result[1] = _az_shift_right_128(middle, high, shift);
+}
+
+// Returns (m * multiplier) >> shift, for a value of m of at most 55 bits and 64 < shift < 128.
+AZ_NODISCARD AZ_INLINE uint64_t
+_az_multiply_shift_64(uint64_t m, uint64_t const multiplier[2], int32_t shift)
+{
+  _az_uint128 const high_product = _az_multiply_64x64(m, multiplier[1]);
+  _az_uint128 const low_product = _az_multiply_64x64(m, multiplier[0]);
+
+  uint64_t const middle = low_product.high + high_product.low;
+  uint64_t const high = high_product.high + (middle < low_product.high ? 1U : 0U);
+  return _az_shift_right_128(middle, high, shift - 64);
+}
+
+AZ_NODISCARD AZ_INLINE bool _az_is_multiple_of_power_of_five(uint64_t value, int32_t power)
+{
+  int32_t count = 0;
+  while (value % 5 == 0)
+  {
+    value /= 5;
+    count++;
+  }
+  return count >= power;
+}
+
+AZ_NODISCARD AZ_INLINE bool _az_is_multiple_of_power_of_two(uint64_t value, int32_t power)
+{
+  return (value & ((1ULL << (uint32_t)power) - 1)) == 0;
+}
+
+/**
+ * @brief Finds the shortest decimal number within the interval of numbers that round to the
+ * finite, positive double with the given \p mantissa and biased \p exponent bits. When several
+ * numbers with the same number of digits qualify, the closest to the exact value is returned.
+ */
+static AZ_NODISCARD _az_decimal_number
+_az_double_to_shortest_decimal(uint64_t mantissa, int32_t exponent)
+{
+  // Step 1: Decode the double, with two extra bits of precision for the bounds of the interval.
+  int32_t e2 = 0;
+  uint64_t m2 = 0;
+  if (exponent == 0)
+  {
+    e2 = 1 - _az_DOUBLE_EXPONENT_BIAS - _az_DOUBLE_MANTISSA_BITS - 2;
+    m2 = mantissa;
+  }
+  else
+  {
+    e2 = exponent - _az_DOUBLE_EXPONENT_BIAS - _az_DOUBLE_MANTISSA_BITS - 2;
+    m2 = (1ULL << _az_DOUBLE_MANTISSA_BITS) | mantissa;
+  }
+
+  // A number exactly halfway between two doubles rounds to the one with an even mantissa, so the
+  // bounds of the interval are only included when the mantissa is even.
+  bool const accept_bounds = (m2 & 1) == 0;
+
+  // Step 2: The interval of numbers which round to this double is (mm, mp) * 2^e2, where the lower
+  // bound is closer when the mantissa is the smallest of a power of two.
+  uint64_t const mv = 4 * m2;
+  uint32_t const mm_shift = (mantissa != 0 || exponent <= 1) ? 1U : 0U;
+
+  // Step 3: Convert the interval to a decimal power base, vr, vp and vm being the value and the
+  // upper and lower bounds, scaled by 10^-e10.
+  uint64_t vr = 0;
+  uint64_t vp = 0;
+  uint64_t vm = 0;
+  int32_t e10 = 0;
+  bool vm_is_trailing_zeros = false;
+  bool vr_is_trailing_zeros = false;
+  uint64_t power[2] = { 0 };
+
+  if (e2 >= 0)
+  {
+    int32_t const q = _az_log10_of_power_of_two(e2) - (e2 > 3 ? 1 : 0);
+    e10 = q;
+    int32_t const k = _az_POWER_OF_FIVE_BITS + _az_power_of_five_bits(q) - 1;
+    int32_t const i = -e2 + q + k;
+
+    _az_compute_inverse_power_of_five(q, power);
+    vr = _az_multiply_shift_64(mv, power, i);
+    vp = _az_multiply_shift_64(mv + 2, power, i);
+    vm = _az_multiply_shift_64(mv - 1 - mm_shift, power, i);
+
+    if (q <= 21)
+    {
+      // Only one of mp, mv, and mm can be a multiple of 5, if any.
+      if (mv % 5 == 0)
+      {
+        vr_is_trailing_zeros = _az_is_multiple_of_power_of_five(mv, q);
+      }
+      else if (accept_bounds)
+      {
+        vm_is_trailing_zeros = _az_is_multiple_of_power_of_five(mv - 1 - mm_shift, q);
+      }
+      else if (_az_is_multiple_of_power_of_five(mv + 2, q))
+      {
+        vp--;
+      }
+    }
+  }
+  else
+  {
+    int32_t const q = _az_log10_of_power_of_five(-e2) - (-e2 > 1 ? 1 : 0);
+    e10 = q + e2;
+    int32_t const i = -e2 - q;
+    int32_t const k = _az_power_of_five_bits(i) - _az_POWER_OF_FIVE_BITS;
+    int32_t const j = q - k;
+
+    _az_compute_power_of_five(i, power);
+    vr = _az_multiply_shift_64(mv, power, j);
+    vp = _az_multiply_shift_64(mv + 2, power, j);
+    vm = _az_multiply_shift_64(mv - 1 - mm_shift, power, j);
+
+    if (q <= 1)
+    {
+      // mv has at least 2 trailing zero bits, so {vr,vp,vm} all have at least q trailing zeros.
+      vr_is_trailing_zeros = true;
+      if (accept_bounds)
+      {
+        // mm = mv - 1 - mm_shift has 1 trailing zero bit exactly when mm_shift is 1.
+        vm_is_trailing_zeros = mm_shift == 1;
+      }
+      else
+      {
+        // mp = mv + 2 always has at least 1 trailing zero bit.
+        vp--;
+      }
+    }
+    else if (q < 63)
+    {
+      vr_is_trailing_zeros = _az_is_multiple_of_power_of_two(mv, q);
+    }
+  }
+
+  // Step 4: Remove as many digits as possible, while the value stays within the interval.
+  int32_t removed = 0;
+  uint64_t output = 0;
+
+  if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+  {
+    // The general case, which happens rarely.
+    uint32_t last_removed_digit = 0;
+    while (vp / 10 > vm / 10)
+    {
+      vm_is_trailing_zeros = vm_is_trailing_zeros && vm % 10 == 0;
+      vr_is_trailing_zeros = vr_is_trailing_zeros && last_removed_digit == 0;
+      last_removed_digit = (uint32_t)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+
+    if (vm_is_trailing_zeros)
+    {
+      while (vm % 10 == 0)
+      {
+        vr_is_trailing_zeros = vr_is_trailing_zeros && last_removed_digit == 0;
+        last_removed_digit = (uint32_t)(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        removed++;
+      }
+    }
+
+    if (vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0)
+    {
+      // Round exact ties to even.
+      last_removed_digit = 4;
+    }
+
+    bool const round_up = (vr == vm && (!accept_bounds || !vm_is_trailing_zeros))
+        || last_removed_digit >= 5;
+    output = vr + (round_up ? 1U : 0U);
+  }
+  else
+  {
+    // The common case, where none of the bounds are exact.
+    bool round_up = false;
+    if (vp / 100 > vm / 100)
+    {
+      round_up = vr % 100 >= 50;
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      removed += 2;
+    }
+
+    while (vp / 10 > vm / 10)
+    {
+      round_up = vr % 10 >= 5;
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+
+    output = vr + ((vr == vm || round_up) ? 1U : 0U);
+  }
+
+  return (_az_decimal_number){ .digits = output, .exponent = e10 + removed };
+}
+
+/**
+ * @brief Returns the exact value of a finite, positive double which is an integer below 2^53, with
+ * its trailing zeros moved into the exponent, or false if the double isn't such an integer.
+ */
+AZ_NODISCARD AZ_INLINE bool
+_az_double_to_small_integer(uint64_t mantissa, int32_t exponent, _az_decimal_number* out_number)
+{
+  uint64_t const m2 = (1ULL << _az_DOUBLE_MANTISSA_BITS) | mantissa;
+  int32_t const e2 = exponent - _az_DOUBLE_EXPONENT_BIAS - _az_DOUBLE_MANTISSA_BITS;
+
+  if (e2 > 0 || e2 < -_az_DOUBLE_MANTISSA_BITS)
+  {
+    return false;
+  }
+
+  uint32_t const shift = (uint32_t)-e2;
+  if ((m2 & ((1ULL << shift) - 1)) != 0)
+  {
+    // The number has a fractional part.
+    return false;
+  }
+
+  *out_number = (_az_decimal_number){ .digits = m2 >> shift, .exponent = 0 };
+  while (out_number->digits % 10 == 0)
+  {
+    out_number->digits /= 10;
+    out_number->exponent++;
+  }
+
+  return true;
+}
+
+AZ_NODISCARD az_result az_span_dtoa_shortest(az_span destination, double source, az_span* out_span)
+{
+  _az_PRECONDITION_VALID_SPAN(destination, 0, false);
+  // Inputs that are either positive or negative infinity, or not a number, are not supported.
+  _az_PRECONDITION(_az_isfinite(source));
+  _az_PRECONDITION_NOT_NULL(out_span);
+
+  *out_span = destination;
+
+  uint64_t bits = 0;
+  memcpy(&bits, &source, sizeof(bits));
+
+  bool const negative = (bits >> 63U) != 0;
+  uint64_t const mantissa = bits & ((1ULL << _az_DOUBLE_MANTISSA_BITS) - 1);
+  int32_t const exponent
+      = (int32_t)((bits >> _az_DOUBLE_MANTISSA_BITS) & (uint64_t)_az_DOUBLE_INFINITE_POWER);
+
+  // The input is either positive or negative infinity, or not a number.
+  if (exponent == _az_DOUBLE_INFINITE_POWER)
+  {
+    return AZ_ERROR_NOT_SUPPORTED;
+  }
+
+  _az_decimal_number number = { .digits = 0, .exponent = 0 };
+  if ((exponent != 0 || mantissa != 0)
+      && !_az_double_to_small_integer(mantissa, exponent, &number))
+  {
+    number = _az_double_to_shortest_decimal(mantissa, exponent);
+  }
+
+  int32_t const digit_count = _az_span_u64toa_size(number.digits);
+  uint8_t digits[_az_MAX_SHORTEST_DOUBLE_DIGITS];
+  _az_span_write_uint64_digits(digits, number.digits, digit_count);
+
+  // The position of the decimal point, relative to the first digit.
+  int32_t const point = number.exponent + digit_count;
+
+  int32_t required_size = negative ? 1 : 0;
+  int32_t exponent_size = 0;
+  if (point >= digit_count && point <= _az_MAX_DECIMAL_NOTATION_EXPONENT)
+  {
+    // An integer, e.g. 1500.
+    required_size += point;
+  }
+  else if (point > 0 && point <= _az_MAX_DECIMAL_NOTATION_EXPONENT)
+  {
+    // The decimal point is within the digits, e.g. 1.5.
+    required_size += digit_count + 1;
+  }
+  else if (point > _az_MIN_DECIMAL_NOTATION_EXPONENT && point <= 0)
+  {
+    // The leading zeros need to be written after the decimal point, e.g. 0.0015.
+    required_size += 2 - point + digit_count;
+  }
+  else
+  {
+    // Exponent notation, e.g. 1.5e+300.
+    int32_t const absolute_exponent = point - 1 < 0 ? 1 - point : point - 1;
+    exponent_size = absolute_exponent >= 100 ? 3 : (absolute_exponent >= 10 ? 2 : 1);
+    required_size += digit_count + (digit_count > 1 ? 1 : 0) + 2 + exponent_size;
+  }
+
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(*out_span, required_size);
+
+  if (negative)
+  {
+    *out_span = az_span_copy_u8(*out_span, '-');
+  }
+
+  if (exponent_size == 0)
+  {
+    if (point <= 0)
+    {
+      *out_span = az_span_copy_u8(*out_span, '0');
+      *out_span = az_span_copy_u8(*out_span, '.');
+      for (int32_t i = point; i < 0; i++)
+      {
+        *out_span = az_span_copy_u8(*out_span, '0');
+      }
+      *out_span = az_span_copy(*out_span, az_span_create(digits, digit_count));
+    }
+    else if (point < digit_count)
+    {
+      *out_span = az_span_copy(*out_span, az_span_create(digits, point));
+      *out_span = az_span_copy_u8(*out_span, '.');
+      *out_span = az_span_copy(
+          *out_span, az_span_create(digits + point, digit_count - point));
+    }
+    else
+    {
+      *out_span = az_span_copy(*out_span, az_span_create(digits, digit_count));
+      for (int32_t i = digit_count; i < point; i++)
+      {
+        *out_span = az_span_copy_u8(*out_span, '0');
+      }
+    }
+
+    return AZ_OK;
+  }
+
+  *out_span = az_span_copy_u8(*out_span, digits[0]);
+  if (digit_count > 1)
+  {
+    *out_span = az_span_copy_u8(*out_span, '.');
+    *out_span = az_span_copy(
+        *out_span, az_span_create(digits + 1, digit_count - 1));
+  }
+
+  *out_span = az_span_copy_u8(*out_span, 'e');
+  *out_span = az_span_copy_u8(*out_span, point - 1 < 0 ? '-' : '+');
+
+  int32_t absolute_exponent = point - 1 < 0 ? 1 - point : point - 1;
+  for (int32_t i = exponent_size - 1; i >= 0; i--)
+  {
+    az_span_ptr(*out_span)[i] = (uint8_t)('0' + absolute_exponent % 10);
+    absolute_exponent /= 10;
+  }
+  *out_span = az_span_slice_to_end(*out_span, exponent_size);
+
+  return AZ_OK;
+}
@@ -10,6 +10,12 @@
 #include <azure/core/internal/az_precondition_internal.h>
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#pragma intrinsic(_umul128)
+#endif
 
 #include <azure/core/_az_cfg_prefix.h>
 
@@ -17,6 +23,10 @@
 // for the fraction bits.
 #define _az_BINARY_VALUE_OF_POSITIVE_INFINITY 0x7FF0000000000000ULL
 
+// The maximum integer value that can be stored in a double without losing precision (2^53 - 1)
+// An IEEE 64-bit double has 52 bits of mantissa
+#define _az_MAX_SAFE_INTEGER 9007199254740991
+
 enum
 {
   _az_ASCII_LOWER_DIF = 'a' - 'A',
@@ -33,9 +43,12 @@ enum
   // 19 + sign (i.e. -9,223,372,036,854,775,808)
   _az_MAX_SIZE_FOR_INT64 = 20,
 
-  // Two digit length to create the "format" passed to sscanf.
+  // The longest number text accepted when parsing a double.
   _az_MAX_SIZE_FOR_PARSING_DOUBLE = 99,
 
+  // [-]0.00000[0-9]{17}, the longest output of az_span_dtoa_shortest.
+  _az_MAX_SIZE_FOR_WRITING_SHORTEST_DOUBLE = 25,
+
   // The number value of the ASCII space character ' '.
   _az_ASCII_SPACE_CHARACTER = 0x20,
 
@@ -135,6 +148,176 @@ AZ_NODISCARD az_span _az_span_trim_whitespace_from_start(az_span source);
  */
 AZ_NODISCARD az_span _az_span_trim_whitespace_from_end(az_span source);
 
+/**
+ * @brief Writes the \p digit_count digits (base 10) of \p number at \p destination, two at a time.
+ *
+ * @param[out] destination The buffer to write the digits to, which must be able to hold \p
+ * digit_count bytes.
+ * @param[in] number The number to write.
+ * @param[in] digit_count The number of digits of \p number, as returned by #_az_span_u64toa_size().
+ */
+void _az_span_write_uint64_digits(uint8_t* destination, uint64_t number, int32_t digit_count);
+
+/**
+ * @brief The bytes of a number, which may be split across consecutive buffer segments, such as a
+ * JSON number token read from non-contiguous buffers.
+ */
+typedef struct
+{
+  /// The array of buffer segments.
+  az_span const* segments;
+
+  /// The index of the segment being read.
+  int32_t segment_index;
+
+  /// The index of the segment containing the last byte.
+  int32_t last_segment_index;
+
+  /// The number of bytes of the last segment which are part of the number.
+  int32_t last_segment_size;
+
+  /// The next byte to read within the segment being read.
+  uint8_t const* next;
+
+  /// The end of the bytes of the segment being read.
+  uint8_t const* end;
+} _az_span_segments;
+
+/**
+ * @brief Creates an #_az_span_segments over the bytes from \p first_segment_offset within the
+ * segment at \p first_segment_index, up to \p last_segment_size bytes into the segment at \p
+ * last_segment_index.
+ */
+AZ_NODISCARD AZ_INLINE _az_span_segments _az_span_segments_create(
+    az_span const* segments,
+    int32_t first_segment_index,
+    int32_t first_segment_offset,
+    int32_t last_segment_index,
+    int32_t last_segment_size)
+{
+  az_span const first_segment = segments[first_segment_index];
+  int32_t const first_segment_size = first_segment_index == last_segment_index
+      ? last_segment_size
+      : az_span_size(first_segment);
+
+  return (_az_span_segments){
+    .segments = segments,
+    .segment_index = first_segment_index,
+    .last_segment_index = last_segment_index,
+    .last_segment_size = last_segment_size,
+    .next = az_span_ptr(first_segment) + first_segment_offset,
+    .end = az_span_ptr(first_segment) + first_segment_size,
+  };
+}
+
+/**
+ * @brief Parses the bytes of \p source, which must be a decimal number without leading whitespace,
+ * into the nearest `double`.
+ *
+ * @details Implements #az_span_atod(), on bytes which may be split across several segments.
+ *
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The bytes aren't a valid number, or the number would overflow
+ * a `double`.
+ */
+AZ_NODISCARD az_result _az_span_segments_atod(_az_span_segments source, double* out_number);
+
+/**
+ * @brief Converts `mantissa * 10^exponent` to a `double` with a single floating point operation,
+ * when that is exact, which is the case when both the \p mantissa and the power of ten are exactly
+ * representable as a `double`.
+ *
+ * @return `true` if \p out_number was set to the correctly rounded value, or `false` if the number
+ * needs to be parsed from its text instead.
+ */
+AZ_NODISCARD bool _az_span_exact_decimal_to_double(
+    uint64_t mantissa,
+    int32_t exponent,
+    double* out_number);
+
+/**
+ * @brief The state of a UTF-8 validation, which can be continued across several calls to
+ * #_az_utf8_validate(), such as when the text straddles non-contiguous buffers.
+ *
+ * @details Zero-initialize it before validating the first bytes of the text.
+ */
+typedef struct
+{
+  uint8_t continuation_bytes; ///< The continuation bytes still expected by the current sequence.
+  uint8_t next_min; ///< The smallest value allowed for the next continuation byte.
+  uint8_t next_max; ///< The largest value allowed for the next continuation byte.
+} _az_utf8_validator;
+
+/**
+ * @brief Validates the next part of some UTF-8 text, rejecting overlong encodings, surrogates, and
+ * code points beyond U+10FFFF.
+ *
+ * @param[in,out] ref_validator The state of the validation, continued from any previous parts.
+ * @param[in] text The next bytes of the text.
+ *
+ * @return `false` if \p text can't be part of valid UTF-8 text, otherwise `true`, though the text
+ * could end in the middle of a multi-byte sequence, see #_az_utf8_validator_is_complete().
+ */
+AZ_NODISCARD bool _az_utf8_validate(_az_utf8_validator* ref_validator, az_span text);
+
+/**
+ * @brief Returns `true` if the text validated so far doesn't end in the middle of a multi-byte
+ * sequence.
+ */
+AZ_NODISCARD AZ_INLINE bool _az_utf8_validator_is_complete(_az_utf8_validator const* validator)
+{
+  return validator->continuation_bytes == 0;
+}
+
+/**
+ * @brief Returns `true` if all of \p text is valid UTF-8.
+ */
+AZ_NODISCARD AZ_INLINE bool _az_span_is_valid_utf8(az_span text)
+{
+  _az_utf8_validator validator = { 0 };
+  return _az_utf8_validate(&validator, text) && _az_utf8_validator_is_complete(&validator);
+}
+
+/**
+ * @brief An unsigned 128-bit integer, used by the conversions between decimal text and `double`.
+ */
+typedef struct
+{
+  uint64_t high;
+  uint64_t low;
+} _az_uint128;
+
+/**
+ * @brief Returns the full 128-bit product of \p a and \p b.
+ */
+AZ_NODISCARD AZ_INLINE _az_uint128 _az_multiply_64x64(uint64_t a, uint64_t b)
+{
+  _az_uint128 result;
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 _az_native_uint128;
+  _az_native_uint128 const product = (_az_native_uint128)a * b;
+  result.high = (uint64_t)(product >> 64U);
+  result.low = (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+  result.low = _umul128(a, b, &result.high);
+#else
+  uint64_t const a_low = (uint32_t)a;
+  uint64_t const a_high = a >> 32U;
+  uint64_t const b_low = (uint32_t)b;
+  uint64_t const b_high = b >> 32U;
+
+  uint64_t const low_low = a_low * b_low;
+  uint64_t const high_low = a_high * b_low;
+  uint64_t const low_high = a_low * b_high;
+  uint64_t const high_high = a_high * b_high;
+
+  uint64_t const middle = (low_low >> 32U) + (uint32_t)high_low + low_high;
+  result.low = (middle << 32U) | (uint32_t)low_low;
+  result.high = high_high + (high_low >> 32U) + (middle >> 32U);
+#endif
+  return result;
+}
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_SPAN_PRIVATE_H
@@ -175,38 +175,12 @@ AZ_NODISCARD int32_t az_iot_calculate_retry_delay(
 
 AZ_NODISCARD int32_t _az_iot_u32toa_size(uint32_t number)
 {
-  if (number == 0)
-  {
-    return 1;
-  }
-
-  uint32_t div = _az_SMALLEST_10_DIGIT_NUMBER;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT32;
-  while (number / div == 0)
-  {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
-  }
-
-  return digit_count;
+  return _az_span_u32toa_size(number);
 }
 
 AZ_NODISCARD int32_t _az_iot_u64toa_size(uint64_t number)
 {
-  if (number == 0)
-  {
-    return 1;
-  }
-
-  uint64_t div = _az_SMALLEST_20_DIGIT_NUMBER;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT64;
-  while (number / div == 0)
-  {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
-  }
-
-  return digit_count;
+  return _az_span_u64toa_size(number);
 }
 
 AZ_NODISCARD az_result
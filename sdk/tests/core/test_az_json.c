@@ -229,6 +229,238 @@ static void test_json_writer(void** state)
   }
 }
 
+static void test_json_writer_append_double_shortest(void** state)
+{
+  (void)state;
+  {
+    uint8_t array[200] = { 0 };
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 0));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, -12.5));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 0.1));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 1.0 / 3));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 9007199254740993.0 * 4));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 1e-7));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, -1.7976931348623157e308));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&writer));
+
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("[0,-12.5,0.1,0.3333333333333333,36028797018963970,1e-7,"
+                         "-1.7976931348623157e+308]")));
+  }
+  {
+    // Only the space the number needs is needed, along with the leading comma.
+    uint8_t array[26] = { 0 };
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, az_span_create(array, 8), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 1.5));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, 1.5));
+    assert_int_equal(
+        az_json_writer_append_double_shortest(&writer, 1.5), AZ_ERROR_NOT_ENOUGH_SPACE);
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer), AZ_SPAN_FROM_STR("[1.5,1.5")));
+
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_shortest(&writer, -2.2250738585072014e-308));
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("-2.2250738585072014e-308")));
+  }
+}
+
+static void test_json_writer_append_int64(void** state)
+{
+  (void)state;
+  {
+    uint8_t array[200] = { 0 };
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("min")));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, INT64_MIN));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("max")));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, INT64_MAX));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("list")));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, 0));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, -1));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, 1600000000123));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("{\"min\":-9223372036854775808,\"max\":9223372036854775807,"
+                         "\"list\":[0,-1,1600000000123]}")));
+  }
+  {
+    // Only the space the number needs is needed, along with the leading comma.
+    uint8_t array[4] = { 0 };
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, 1));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, 2));
+    assert_int_equal(az_json_writer_append_int64(&writer, 3), AZ_ERROR_NOT_ENOUGH_SPACE);
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer), AZ_SPAN_FROM_STR("[1,2")));
+  }
+}
+
+static void test_json_writer_escape_runs(void** state)
+{
+  (void)state;
+
+  struct
+  {
+    uint8_t byte;
+    char* escaped;
+  } const cases[] = {
+    { '"', "\\\"" },     { '\\', "\\\\" },     { '\n', "\\n" },     { '\t', "\\t" },
+    { 0x01, "\\u0001" }, { 0x1F, "\\u001F" }, { 0x7F, "\x7F" }, { 0xC3, "\xC3" },
+  };
+
+  // The character that needs to be escaped is found at any position, within short strings and
+  // within strings that are written in chunks.
+  int32_t const sizes[] = { 9, 40 };
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+  {
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+      for (int32_t position = 0; position < sizes[i]; position++)
+      {
+        uint8_t text_buffer[40] = { 0 };
+        az_span const text = az_span_slice(AZ_SPAN_FROM_BUFFER(text_buffer), 0, sizes[i]);
+        az_span_fill(text, 'a');
+        text_buffer[position] = cases[c].byte;
+
+        uint8_t escaped_buffer[64] = { 0 };
+        az_span remainder = az_span_copy(
+            AZ_SPAN_FROM_BUFFER(escaped_buffer), az_span_slice(text, 0, position));
+        remainder = az_span_copy(remainder, az_span_create_from_str(cases[c].escaped));
+        remainder = az_span_copy(remainder, az_span_slice_to_end(text, position + 1));
+        az_span const escaped = az_span_slice(
+            AZ_SPAN_FROM_BUFFER(escaped_buffer),
+            0,
+            (int32_t)(az_span_ptr(remainder) - escaped_buffer));
+
+        uint8_t expected_buffer[256] = { 0 };
+        remainder = az_span_copy(AZ_SPAN_FROM_BUFFER(expected_buffer), AZ_SPAN_FROM_STR("{\""));
+        remainder = az_span_copy(remainder, escaped);
+        remainder = az_span_copy(remainder, AZ_SPAN_FROM_STR("\":\""));
+        remainder = az_span_copy(remainder, escaped);
+        remainder = az_span_copy(remainder, AZ_SPAN_FROM_STR("\"}"));
+        az_span const expected = az_span_slice(
+            AZ_SPAN_FROM_BUFFER(expected_buffer),
+            0,
+            (int32_t)(az_span_ptr(remainder) - expected_buffer));
+
+        uint8_t buffer[256] = { 0 };
+        az_json_writer writer = { 0 };
+        TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+        TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+        TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, text));
+        TEST_EXPECT_SUCCESS(az_json_writer_append_string(&writer, text));
+        TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+
+        assert_true(az_span_is_content_equal(
+            az_json_writer_get_bytes_used_in_destination(&writer), expected));
+      }
+    }
+  }
+}
+
+static void test_json_writer_prepared_property_name(void** state)
+{
+  (void)state;
+
+  az_span const long_name
+      = AZ_SPAN_FROM_STR("a property name which is longer than a single chunk of the json writer");
+
+  uint8_t name_buffer[16] = { 0 };
+  uint8_t escaped_name_buffer[16] = { 0 };
+  uint8_t long_name_buffer[80] = { 0 };
+  az_json_prepared_property_name name = { 0 };
+  az_json_prepared_property_name escaped_name = { 0 };
+  az_json_prepared_property_name long_prepared_name = { 0 };
+  az_json_prepared_property_name const literal_name
+      = AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR("literal");
+
+  TEST_EXPECT_SUCCESS(az_json_prepared_property_name_init(
+      &name, AZ_SPAN_FROM_STR("name"), AZ_SPAN_FROM_BUFFER(name_buffer)));
+  TEST_EXPECT_SUCCESS(az_json_prepared_property_name_init(
+      &escaped_name, AZ_SPAN_FROM_STR("a\"b\n"), AZ_SPAN_FROM_BUFFER(escaped_name_buffer)));
+  TEST_EXPECT_SUCCESS(az_json_prepared_property_name_init(
+      &long_prepared_name, long_name, AZ_SPAN_FROM_BUFFER(long_name_buffer)));
+
+  // The buffer needs room for the escaped name, the quotes, the comma, and the colon.
+  az_json_prepared_property_name too_small = { 0 };
+  assert_int_equal(
+      az_json_prepared_property_name_init(
+          &too_small, AZ_SPAN_FROM_STR("a\"b\n"), az_span_create(escaped_name_buffer, 9)),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_prepared_property_name_init(
+      &too_small, AZ_SPAN_FROM_STR("a\"b\n"), az_span_create(escaped_name_buffer, 10)));
+
+  // The prepared names are written the same as when they are escaped while appending them.
+  uint8_t buffer[256] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_prepared_property_name(&writer, &name));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int32(&writer, 1));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_prepared_property_name(&writer, &escaped_name));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_prepared_property_name(&writer, &literal_name));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_bool(&writer, true));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_prepared_property_name(&writer, &long_prepared_name));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_null(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+
+  uint8_t expected_buffer[256] = { 0 };
+  az_json_writer expected_writer = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_init(&expected_writer, AZ_SPAN_FROM_BUFFER(expected_buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&expected_writer));
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_append_property_name(&expected_writer, AZ_SPAN_FROM_STR("name")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int32(&expected_writer, 1));
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_append_property_name(&expected_writer, AZ_SPAN_FROM_STR("a\"b\n")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&expected_writer));
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_append_property_name(&expected_writer, AZ_SPAN_FROM_STR("literal")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_bool(&expected_writer, true));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&expected_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&expected_writer, long_name));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_null(&expected_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&expected_writer));
+
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&writer),
+      az_json_writer_get_bytes_used_in_destination(&expected_writer)));
+  assert_int_equal(
+      writer._internal.total_bytes_written, expected_writer._internal.total_bytes_written);
+
+  // There must be enough space for the whole property name.
+  uint8_t small_buffer[8] = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(small_buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+  assert_int_equal(
+      az_json_writer_append_prepared_property_name(&writer, &literal_name),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_prepared_property_name(&writer, &name));
+}
+
 static void test_json_writer_append_nested(void** state)
 {
   (void)state;
@@ -984,6 +1216,255 @@ static void test_json_writer_large_string_chunked(void** state)
   }
 }
 
+static void test_json_writer_pooled(void** state)
+{
+  (void)state;
+
+  uint8_t chunk_buffers[5][80] = { { 0 } };
+  az_span chunks[5] = {
+    AZ_SPAN_FROM_BUFFER(chunk_buffers[0]),
+    az_span_create(chunk_buffers[1], 8), // Too small for any string, so it is skipped.
+    AZ_SPAN_FROM_BUFFER(chunk_buffers[2]),
+    AZ_SPAN_FROM_BUFFER(chunk_buffers[3]),
+    AZ_SPAN_FROM_BUFFER(chunk_buffers[4]),
+  };
+  az_json_writer_segment segments[5] = { { 0 } };
+
+  az_json_writer_chunk_pool chunk_pool = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_chunk_pool_init(&chunk_pool, chunks, 5, segments, 5));
+
+  uint8_t expected_buffer[300] = { 0 };
+  az_json_writer expected_writer = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_init(&expected_writer, AZ_SPAN_FROM_BUFFER(expected_buffer), NULL));
+
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_pooled_init(&writer, &chunk_pool, NULL));
+
+  az_json_writer* const writers[2] = { &writer, &expected_writer };
+  for (int32_t i = 0; i < 2; i++)
+  {
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(writers[i]));
+    TEST_EXPECT_SUCCESS(
+        az_json_writer_append_property_name(writers[i], AZ_SPAN_FROM_STR("description")));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_string(
+        writers[i],
+        AZ_SPAN_FROM_STR("a string value which is long enough to need more than one chunk of the "
+                         "pool, along with the values that follow it")));
+    TEST_EXPECT_SUCCESS(
+        az_json_writer_append_property_name(writers[i], AZ_SPAN_FROM_STR("values")));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(writers[i]));
+    for (int32_t value = 0; value < 10; value++)
+    {
+      TEST_EXPECT_SUCCESS(az_json_writer_append_int32(writers[i], value * 1000));
+    }
+    TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(writers[i]));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(writers[i]));
+  }
+
+  int32_t number_of_segments = 0;
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_chunk_pool_get_segments(&chunk_pool, &writer, &number_of_segments));
+  assert_true(number_of_segments > 1);
+
+  // The segments hold the JSON text in order, within the chunks that were large enough.
+  uint8_t gathered_buffer[300] = { 0 };
+  az_span remainder = AZ_SPAN_FROM_BUFFER(gathered_buffer);
+  for (int32_t i = 0; i < number_of_segments; i++)
+  {
+    assert_true(segments[i].base != chunk_buffers[1]);
+    remainder = az_span_copy(
+        remainder, az_span_create((uint8_t*)segments[i].base, (int32_t)segments[i].size));
+  }
+  az_span const gathered = az_span_slice(
+      AZ_SPAN_FROM_BUFFER(gathered_buffer),
+      0,
+      _az_span_diff(remainder, AZ_SPAN_FROM_BUFFER(gathered_buffer)));
+  assert_true(az_span_is_content_equal(
+      gathered, az_json_writer_get_bytes_used_in_destination(&expected_writer)));
+
+  // Getting the segments again gives the same result.
+  int32_t number_of_segments_again = 0;
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_chunk_pool_get_segments(&chunk_pool, &writer, &number_of_segments_again));
+  assert_int_equal(number_of_segments_again, number_of_segments);
+
+  // Once the pool runs out of chunks, the writer runs out of space.
+  TEST_EXPECT_SUCCESS(az_json_writer_chunk_pool_init(&chunk_pool, chunks, 2, segments, 5));
+  TEST_EXPECT_SUCCESS(az_json_writer_pooled_init(&writer, &chunk_pool, NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  az_result result = AZ_OK;
+  for (int32_t value = 0; value < 100 && az_result_succeeded(result); value++)
+  {
+    result = az_json_writer_append_int32(&writer, value);
+  }
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
+#define _az_STREAMED_PART_COUNT 58
+
+// Appends the given part of the test document, which has _az_STREAMED_PART_COUNT parts.
+static az_result _az_json_writer_append_next_streamed_part(az_json_writer* writer, int32_t part)
+{
+  if (part == 0)
+  {
+    return az_json_writer_append_begin_object(writer);
+  }
+  if (part == _az_STREAMED_PART_COUNT - 1)
+  {
+    return az_json_writer_append_end_object(writer);
+  }
+
+  // Each property is a name and an object with a string and a number.
+  int32_t const property_part = (part - 1) % 7;
+  switch (property_part)
+  {
+    case 0:
+      return az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("component"));
+    case 1:
+      return az_json_writer_append_begin_object(writer);
+    case 2:
+      return az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("name"));
+    case 3:
+      return az_json_writer_append_string(writer, AZ_SPAN_FROM_STR("a \"value\"\n"));
+    case 4:
+      return az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("value"));
+    case 5:
+      return az_json_writer_append_int32(writer, part * 1000);
+    default:
+      return az_json_writer_append_end_object(writer);
+  }
+}
+
+static void test_json_writer_checkpoint_and_flush(void** state)
+{
+  (void)state;
+
+  uint8_t expected_buffer[1024] = { 0 };
+  az_json_writer expected_writer = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_init(&expected_writer, AZ_SPAN_FROM_BUFFER(expected_buffer), NULL));
+  for (int32_t part = 0; part < _az_STREAMED_PART_COUNT; part++)
+  {
+    TEST_EXPECT_SUCCESS(_az_json_writer_append_next_streamed_part(&expected_writer, part));
+  }
+
+  // The same document is streamed through a small buffer, by rolling back and flushing whenever an
+  // append doesn't fit.
+  uint8_t small_buffer[32] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(small_buffer), NULL));
+
+  uint8_t streamed_buffer[1024] = { 0 };
+  az_span remainder = AZ_SPAN_FROM_BUFFER(streamed_buffer);
+  int32_t flush_count = 0;
+  for (int32_t part = 0; part < _az_STREAMED_PART_COUNT; part++)
+  {
+    az_json_writer_checkpoint const checkpoint = az_json_writer_get_checkpoint(&writer);
+    az_result result = _az_json_writer_append_next_streamed_part(&writer, part);
+    if (result == AZ_ERROR_NOT_ENOUGH_SPACE)
+    {
+      az_json_writer_rollback(&writer, &checkpoint);
+
+      az_span json_text = AZ_SPAN_EMPTY;
+      TEST_EXPECT_SUCCESS(az_json_writer_flush(&writer, &json_text));
+      remainder = az_span_copy(remainder, json_text);
+      flush_count++;
+
+      result = _az_json_writer_append_next_streamed_part(&writer, part);
+    }
+    TEST_EXPECT_SUCCESS(result);
+  }
+
+  az_span json_text = AZ_SPAN_EMPTY;
+  TEST_EXPECT_SUCCESS(az_json_writer_flush(&writer, &json_text));
+  remainder = az_span_copy(remainder, json_text);
+
+  assert_true(flush_count > 10);
+  assert_true(az_span_is_content_equal(
+      az_span_slice(
+          AZ_SPAN_FROM_BUFFER(streamed_buffer),
+          0,
+          _az_span_diff(remainder, AZ_SPAN_FROM_BUFFER(streamed_buffer))),
+      az_json_writer_get_bytes_used_in_destination(&expected_writer)));
+  assert_int_equal(
+      writer._internal.total_bytes_written, expected_writer._internal.total_bytes_written);
+
+  // Rolling back discards what was written since the checkpoint, and restores the nesting.
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(small_buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int32(&writer, 1));
+  az_json_writer_checkpoint const checkpoint = az_json_writer_get_checkpoint(&writer);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("a")));
+  az_json_writer_rollback(&writer, &checkpoint);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int32(&writer, 2));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&writer));
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&writer), AZ_SPAN_FROM_STR("[1,2]")));
+}
+
+// Appends JSON text which exercises every kind of append, including escaping and long strings.
+static az_result _az_json_writer_append_sizing_document(az_json_writer* writer)
+{
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(writer));
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("a\tb")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_string(
+      writer,
+      AZ_SPAN_FROM_STR("a string which is longer than a chunk, with \"quotes\", a \x01 control "
+                       "character and a \\ backslash")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("numbers")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_array(writer));
+  _az_RETURN_IF_FAILED(az_json_writer_append_int32(writer, 0));
+  _az_RETURN_IF_FAILED(az_json_writer_append_int32(writer, INT32_MIN));
+  _az_RETURN_IF_FAILED(az_json_writer_append_int32(writer, 1000000000));
+  _az_RETURN_IF_FAILED(az_json_writer_append_int64(writer, INT64_MIN));
+  _az_RETURN_IF_FAILED(az_json_writer_append_int64(writer, 9999999999));
+  _az_RETURN_IF_FAILED(az_json_writer_append_double(writer, -21.25, 3));
+  _az_RETURN_IF_FAILED(az_json_writer_append_double_shortest(writer, 0.1));
+  _az_RETURN_IF_FAILED(az_json_writer_append_bool(writer, false));
+  _az_RETURN_IF_FAILED(az_json_writer_append_null(writer));
+  _az_RETURN_IF_FAILED(az_json_writer_append_end_array(writer));
+
+  az_json_prepared_property_name const prepared
+      = AZ_JSON_PREPARED_PROPERTY_NAME_LITERAL_FROM_STR("prepared");
+  _az_RETURN_IF_FAILED(az_json_writer_append_prepared_property_name(writer, &prepared));
+  _az_RETURN_IF_FAILED(
+      az_json_writer_append_json_text(writer, AZ_SPAN_FROM_STR("{ \"json\": [1, true] }")));
+  return az_json_writer_append_end_object(writer);
+}
+
+static void test_json_writer_sizing(void** state)
+{
+  (void)state;
+
+  uint8_t buffer[512] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  TEST_EXPECT_SUCCESS(_az_json_writer_append_sizing_document(&writer));
+
+  az_json_writer sizing_writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_sizing_init(&sizing_writer, NULL));
+  TEST_EXPECT_SUCCESS(_az_json_writer_append_sizing_document(&sizing_writer));
+
+  int32_t const json_size = az_span_size(az_json_writer_get_bytes_used_in_destination(&writer));
+  assert_int_equal(az_json_writer_get_total_bytes_written(&sizing_writer), json_size);
+  assert_int_equal(az_json_writer_get_total_bytes_written(&writer), json_size);
+  assert_int_equal(az_span_size(az_json_writer_get_bytes_used_in_destination(&sizing_writer)), 0);
+
+  // The exact size is enough to write the same JSON text, and one byte less isn't.
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, az_span_create(buffer, json_size), NULL));
+  TEST_EXPECT_SUCCESS(_az_json_writer_append_sizing_document(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, az_span_create(buffer, json_size - 1), NULL));
+  assert_int_equal(_az_json_writer_append_sizing_document(&writer), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // Invalid input is still rejected when sizing.
+  TEST_EXPECT_SUCCESS(az_json_writer_sizing_init(&sizing_writer, NULL));
+  assert_int_equal(
+      az_json_writer_append_json_text(&sizing_writer, AZ_SPAN_FROM_STR("[1,")),
+      AZ_ERROR_UNEXPECTED_END);
+}
+
 /** Json reader **/
 az_result read_write(az_span input, az_span* output, int32_t* o);
 az_result read_write_token(
@@ -1696,121 +2177,1679 @@ static void test_json_skip_children(void** state)
   assert_int_equal(reader._internal.bit_stack._internal.current_depth, 1);
 }
 
-/** Json Value **/
-static void test_json_value(void** state)
+static void test_json_reader_find_paths(void** state)
 {
   (void)state;
 
-  az_json_token const json_boolean = (az_json_token){
-      .kind = AZ_JSON_TOKEN_TRUE,
-      .slice = AZ_SPAN_FROM_STR("true"),
-      ._internal = {
-        .string_has_escaped_chars = false,
-      },
-    };
-  az_json_token const json_number = (az_json_token){
-      .kind = AZ_JSON_TOKEN_NUMBER,
-      .slice = AZ_SPAN_FROM_STR("42"),
-      ._internal = {
-        .string_has_escaped_chars = false,
-      },
-    };
-  az_json_token const json_negative_number = (az_json_token){
-      .kind = AZ_JSON_TOKEN_NUMBER,
-      .slice = AZ_SPAN_FROM_STR("-42"),
-      ._internal = {
-        .string_has_escaped_chars = false,
-      },
-    };
-  az_json_token const json_decimal_number = (az_json_token){
-      .kind = AZ_JSON_TOKEN_NUMBER,
-      .slice = AZ_SPAN_FROM_STR("123.456"),
-      ._internal = {
-        .string_has_escaped_chars = false,
-      },
-    };
-  az_json_token const json_string = (az_json_token){
-      .kind = AZ_JSON_TOKEN_STRING,
-      .slice = AZ_SPAN_FROM_STR("Hello"),
-      ._internal = {
-        .string_has_escaped_chars = false,
-      },
-    };
-  az_json_token const json_property_name = (az_json_token){
-      .kind = AZ_JSON_TOKEN_PROPERTY_NAME,
-      .slice = AZ_SPAN_FROM_STR("Name"),
-      ._internal = {
-        .string_has_escaped_chars = false,
-      },
-    };
+  az_span const twin = AZ_SPAN_FROM_STR(
+      "{\"desired\":{\"thermostat1\":{\"targetTemperature\":47,\"__t\":\"c\"},"
+      "\"skip\":[{\"a\":[1,{\"b\":2}]},\"x\"],\"$version\":5},"
+      "\"reported\":{\"$version\":3,\"list\":[10,[20,21],{\"n\":\"v\"},40]},"
+      "\"a/b\":{\"m~n\":true,\"c\\/d\":null}}");
 
-  // boolean from boolean
-  {
-    bool boolean_value = false;
-    TEST_EXPECT_SUCCESS(az_json_token_get_boolean(&json_boolean, &boolean_value));
-    assert_true(boolean_value);
-  }
-  // boolean from number
   {
-    bool boolean_value = false;
-    assert_true(
-        az_json_token_get_boolean(&json_number, &boolean_value) == AZ_ERROR_JSON_INVALID_STATE);
+    az_span const paths[] = {
+      AZ_SPAN_LITERAL_FROM_STR("/desired/$version"),
+      AZ_SPAN_LITERAL_FROM_STR("/desired/thermostat1/targetTemperature"),
+      AZ_SPAN_LITERAL_FROM_STR("/reported/$version"),
+      AZ_SPAN_LITERAL_FROM_STR("/reported/list/1/0"),
+      AZ_SPAN_LITERAL_FROM_STR("/reported/list/2/n"),
+      AZ_SPAN_LITERAL_FROM_STR("/reported/list/3"),
+      AZ_SPAN_LITERAL_FROM_STR("/a~1b/m~0n"),
+      AZ_SPAN_LITERAL_FROM_STR("/a~1b/c~1d"),
+      AZ_SPAN_LITERAL_FROM_STR("/desired"),
+      AZ_SPAN_LITERAL_FROM_STR("/reported/list/4"),
+      AZ_SPAN_LITERAL_FROM_STR("/desired/$version/nested"),
+      AZ_SPAN_LITERAL_FROM_STR("/missing"),
+      AZ_SPAN_LITERAL_FROM_STR("/a~1b~0xxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+                               "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"),
+    };
+    az_json_token tokens[sizeof(paths) / sizeof(paths[0])];
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, twin, NULL));
+    TEST_EXPECT_SUCCESS(
+        az_json_reader_find_paths(&reader, paths, sizeof(paths) / sizeof(paths[0]), tokens));
+
+    int32_t value = 0;
+    TEST_EXPECT_SUCCESS(az_json_token_get_int32(&tokens[0], &value));
+    assert_int_equal(value, 5);
+    TEST_EXPECT_SUCCESS(az_json_token_get_int32(&tokens[1], &value));
+    assert_int_equal(value, 47);
+    TEST_EXPECT_SUCCESS(az_json_token_get_int32(&tokens[2], &value));
+    assert_int_equal(value, 3);
+    TEST_EXPECT_SUCCESS(az_json_token_get_int32(&tokens[3], &value));
+    assert_int_equal(value, 20);
+    assert_true(az_json_token_is_text_equal(&tokens[4], AZ_SPAN_FROM_STR("v")));
+    TEST_EXPECT_SUCCESS(az_json_token_get_int32(&tokens[5], &value));
+    assert_int_equal(value, 40);
+    assert_int_equal(tokens[6].kind, AZ_JSON_TOKEN_TRUE);
+    assert_int_equal(tokens[7].kind, AZ_JSON_TOKEN_NULL);
+    assert_int_equal(tokens[8].kind, AZ_JSON_TOKEN_BEGIN_OBJECT);
+    assert_int_equal(tokens[9].kind, AZ_JSON_TOKEN_NONE);
+    assert_int_equal(tokens[10].kind, AZ_JSON_TOKEN_NONE);
+    assert_int_equal(tokens[11].kind, AZ_JSON_TOKEN_NONE);
+    // A segment with escapes which is too long to be decoded is never matched.
+    assert_int_equal(tokens[12].kind, AZ_JSON_TOKEN_NONE);
+
+    // Some paths weren't found, so the whole JSON was read.
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+    assert_int_equal(reader._internal.bit_stack._internal.current_depth, 0);
   }
-  // unsigned number from negative number
+
   {
-    uint32_t number_value_u32 = 0;
-    assert_int_equal(
-        az_json_token_get_uint32(&json_negative_number, &number_value_u32),
-        AZ_ERROR_UNEXPECTED_CHAR);
-    uint64_t number_value_u64 = 0;
-    assert_int_equal(
-        az_json_token_get_uint64(&json_negative_number, &number_value_u64),
-        AZ_ERROR_UNEXPECTED_CHAR);
+    // The reader stops as soon as every path is found.
+    az_span const paths[] = { AZ_SPAN_LITERAL_FROM_STR("/desired/$version") };
+    az_json_token tokens[1];
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, twin, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, paths, 1, tokens));
+    assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NUMBER);
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_NUMBER);
+    assert_int_equal(reader._internal.bit_stack._internal.current_depth, 2);
   }
-  // integer number from double number
+
   {
-    uint32_t number_value_u32 = 0;
-    assert_int_equal(
-        az_json_token_get_uint32(&json_decimal_number, &number_value_u32),
-        AZ_ERROR_UNEXPECTED_CHAR);
-    uint64_t number_value_u64 = 0;
-    assert_int_equal(
-        az_json_token_get_uint64(&json_decimal_number, &number_value_u64),
-        AZ_ERROR_UNEXPECTED_CHAR);
-    int32_t number_value_i32 = 0;
-    assert_int_equal(
-        az_json_token_get_int32(&json_decimal_number, &number_value_i32), AZ_ERROR_UNEXPECTED_CHAR);
-    int64_t number_value_i64 = 0;
-    assert_int_equal(
-        az_json_token_get_int64(&json_decimal_number, &number_value_i64), AZ_ERROR_UNEXPECTED_CHAR);
+    // Paths are relative to the current value, and the reader moves from a property name to its
+    // value first.
+    az_span const paths[] = {
+      AZ_SPAN_LITERAL_FROM_STR("/$version"),
+      AZ_SPAN_LITERAL_FROM_STR("/thermostat1/__t"),
+      AZ_SPAN_LITERAL_FROM_STR(""),
+      AZ_SPAN_LITERAL_FROM_STR("/targetTemperature"),
+    };
+    az_json_token tokens[4];
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, twin, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_PROPERTY_NAME);
+    TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, paths, 4, tokens));
+    assert_true(az_span_is_content_equal(tokens[0].slice, AZ_SPAN_FROM_STR("5")));
+    assert_true(az_json_token_is_text_equal(&tokens[1], AZ_SPAN_FROM_STR("c")));
+    assert_int_equal(tokens[2].kind, AZ_JSON_TOKEN_BEGIN_OBJECT);
+    assert_int_equal(tokens[3].kind, AZ_JSON_TOKEN_NONE);
+
+    // The end of the desired object was reached.
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+    assert_int_equal(reader._internal.bit_stack._internal.current_depth, 1);
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_true(az_json_token_is_text_equal(&reader.token, AZ_SPAN_FROM_STR("reported")));
   }
-  // string from string
+
   {
-    char string_value[10] = { 0 };
-    TEST_EXPECT_SUCCESS(az_json_token_get_string(&json_string, string_value, 10, NULL));
-    assert_true(
-        az_span_is_content_equal(az_span_create_from_str(string_value), AZ_SPAN_FROM_STR("Hello")));
+    // Primitive values only match the empty path.
+    az_span const paths[] = { AZ_SPAN_LITERAL_FROM_STR("/a"), AZ_SPAN_LITERAL_FROM_STR("") };
+    az_json_token tokens[2];
 
-    TEST_EXPECT_SUCCESS(az_json_token_get_string(&json_property_name, string_value, 10, NULL));
-    assert_true(
-        az_span_is_content_equal(az_span_create_from_str(string_value), AZ_SPAN_FROM_STR("Name")));
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR(" 42 "), NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, paths, 2, tokens));
+    assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NONE);
+    assert_int_equal(tokens[1].kind, AZ_JSON_TOKEN_NUMBER);
   }
-  // string from boolean
+
   {
-    char string_value[10] = { 0 };
-    assert_true(
-        az_json_token_get_string(&json_boolean, string_value, 10, NULL)
-        == AZ_ERROR_JSON_INVALID_STATE);
+    // Only the first occurrence of a property name is looked within, and the reader stops once no
+    // path can be found anymore.
+    az_span const paths[] = {
+      AZ_SPAN_LITERAL_FROM_STR("/a/b"),
+      AZ_SPAN_LITERAL_FROM_STR("/a/x"),
+      AZ_SPAN_LITERAL_FROM_STR("/c/d"),
+    };
+    az_json_token tokens[3];
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(
+        &reader,
+        AZ_SPAN_FROM_STR("{\"c\":1,\"a\":{\"x\":1},\"a\":{\"b\":2},\"c\":{\"d\":3}}"),
+        NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, paths, 3, tokens));
+    assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NONE);
+    assert_true(az_span_is_content_equal(tokens[1].slice, AZ_SPAN_FROM_STR("1")));
+    assert_int_equal(tokens[2].kind, AZ_JSON_TOKEN_NONE);
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+    assert_int_equal(reader._internal.bit_stack._internal.current_depth, 1);
   }
-  // number from number
+
   {
-    uint64_t number_value = 1;
-    TEST_EXPECT_SUCCESS(az_json_token_get_uint64(&json_number, &number_value));
+    az_span const paths[] = { AZ_SPAN_LITERAL_FROM_STR("/a/b") };
+    az_json_token tokens[1];
 
-    uint64_t const expected_value_bin_rep_view = 42;
-    assert_true(number_value == expected_value_bin_rep_view);
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":{\"c\":[}}"), NULL));
+    assert_int_equal(
+        az_json_reader_find_paths(&reader, paths, 1, tokens), AZ_ERROR_UNEXPECTED_CHAR);
   }
-  // double number from decimal and negative number
+}
+
+static void test_json_reader_cursor(void** state)
+{
+  (void)state;
+
+  az_span const json
+      = AZ_SPAN_FROM_STR("{\"a\":[1,{\"b\":\"x\\ny\"}],\"c\":{\"d\":-2.5},\"e\":true}");
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+
+  // Record a cursor at each token, and check that reading resumes from it with the same tokens.
+  az_json_cursor cursors[20];
+  az_json_token tokens[20];
+  int32_t number_of_tokens = 0;
+
+  cursors[number_of_tokens] = az_json_reader_get_cursor(&reader);
+  tokens[number_of_tokens++] = reader.token;
+  while (az_result_succeeded(az_json_reader_next_token(&reader)))
+  {
+    cursors[number_of_tokens] = az_json_reader_get_cursor(&reader);
+    tokens[number_of_tokens++] = reader.token;
+  }
+
+  assert_int_equal(number_of_tokens, 18);
+  for (int32_t i = 0; i < number_of_tokens; i++)
+  {
+    az_json_reader resumed = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init_at_cursor(&resumed, json, &cursors[i], NULL));
+    assert_int_equal(resumed.token.kind, tokens[i].kind);
+    assert_true(az_span_ptr(resumed.token.slice) == az_span_ptr(tokens[i].slice)
+        || tokens[i].kind == AZ_JSON_TOKEN_NONE);
+    assert_int_equal(az_span_size(resumed.token.slice), az_span_size(tokens[i].slice));
+
+    for (int32_t j = i + 1; j < number_of_tokens; j++)
+    {
+      TEST_EXPECT_SUCCESS(az_json_reader_next_token(&resumed));
+      assert_int_equal(resumed.token.kind, tokens[j].kind);
+      assert_true(az_span_is_content_equal(resumed.token.slice, tokens[j].slice));
+    }
+    assert_int_equal(az_json_reader_next_token(&resumed), AZ_ERROR_JSON_READER_DONE);
+  }
+
+  // The token at a cursor can be read, and skipped, without moving the reader first.
+  az_json_reader resumed = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init_at_cursor(&resumed, json, &cursors[7], NULL));
+  assert_true(az_json_token_is_text_equal(&resumed.token, AZ_SPAN_FROM_STR("x\ny")));
+  TEST_EXPECT_SUCCESS(az_json_reader_init_at_cursor(&resumed, json, &cursors[13], NULL));
+  double value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_double(&resumed.token, &value));
+  assert_true(_is_double_equal(value, -2.5, 1e-15));
+  TEST_EXPECT_SUCCESS(az_json_reader_init_at_cursor(&resumed, json, &cursors[10], NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&resumed));
+  assert_int_equal(resumed.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&resumed));
+  assert_true(az_json_token_is_text_equal(&resumed.token, AZ_SPAN_FROM_STR("e")));
+
+  // An empty string is resumed within its quotes, rather than past the closing one.
+  az_span const empty_string_json = AZ_SPAN_FROM_STR("{\"a\":\"\",\"b\":\"x\"}");
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, empty_string_json, NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+  assert_int_equal(az_span_size(reader.token.slice), 0);
+
+  az_json_cursor const empty_string_cursor = az_json_reader_get_cursor(&reader);
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init_at_cursor(&resumed, empty_string_json, &empty_string_cursor, NULL));
+  assert_int_equal(resumed.token.kind, AZ_JSON_TOKEN_STRING);
+  assert_ptr_equal(az_span_ptr(resumed.token.slice), az_span_ptr(empty_string_json) + 6);
+  assert_int_equal(az_span_size(resumed.token.slice), 0);
+  assert_true(az_json_token_is_text_equal(&resumed.token, AZ_SPAN_EMPTY));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&resumed));
+  assert_true(az_json_token_is_text_equal(&resumed.token, AZ_SPAN_FROM_STR("b")));
+}
+
+static void test_json_document(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      " {\"desired\":{\"thermostat1\":{\"targetTemperature\":47},\"$version\":5},"
+      "\"list\":[1,[],{\"n\\\"\":\"v\"}],\"empty\":{}} ");
+
+  az_json_document_record records[25];
+  az_json_document document = { 0 };
+
+  assert_int_equal(
+      az_json_document_parse(&document, json, records, 24, NULL), AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_document_parse(&document, json, records, 25, NULL));
+  assert_int_equal(az_json_document_get_token_count(&document), 25);
+
+  // Every token is identical to the one returned by the reader.
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  for (int32_t i = 0; i < az_json_document_get_token_count(&document); i++)
+  {
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    az_json_token const token = az_json_document_get_token(&document, i);
+    assert_int_equal(token.kind, reader.token.kind);
+    assert_ptr_equal(az_span_ptr(token.slice), az_span_ptr(reader.token.slice));
+    assert_int_equal(az_span_size(token.slice), az_span_size(reader.token.slice));
+    assert_int_equal(
+        token._internal.string_has_escaped_chars, reader.token._internal.string_has_escaped_chars);
+  }
+  assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+
+  int32_t index = -1;
+  int32_t desired = -1;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_find_property(&document, 0, AZ_SPAN_FROM_STR("desired"), &desired));
+  assert_int_equal(desired, 2);
+
+  TEST_EXPECT_SUCCESS(
+      az_json_document_find_property(&document, desired, AZ_SPAN_FROM_STR("$version"), &index));
+  az_json_token token = az_json_document_get_token(&document, index);
+  int32_t value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_int32(&token, &value));
+  assert_int_equal(value, 5);
+
+  TEST_EXPECT_SUCCESS(az_json_document_get_parent(&document, index, &index));
+  assert_int_equal(index, desired);
+  TEST_EXPECT_SUCCESS(az_json_document_get_parent(&document, desired - 1, &index));
+  assert_int_equal(index, 0);
+  assert_int_equal(az_json_document_get_parent(&document, 0, &index), AZ_ERROR_ITEM_NOT_FOUND);
+
+  // The end of an object is at the same level as its start.
+  TEST_EXPECT_SUCCESS(az_json_document_get_parent(&document, 11, &index));
+  assert_int_equal(index, 0);
+  assert_int_equal(az_json_document_get_parent(&document, 24, &index), AZ_ERROR_ITEM_NOT_FOUND);
+
+  assert_int_equal(
+      az_json_document_find_property(
+          &document, desired, AZ_SPAN_FROM_STR("targetTemperature"), &index),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  // Siblings skip over nested objects and arrays, from either a property name or its value.
+  TEST_EXPECT_SUCCESS(az_json_document_get_next_sibling(&document, desired, &index));
+  token = az_json_document_get_token(&document, index);
+  assert_true(az_json_token_is_text_equal(&token, AZ_SPAN_FROM_STR("list")));
+  TEST_EXPECT_SUCCESS(az_json_document_get_next_sibling(&document, index, &index));
+  token = az_json_document_get_token(&document, index);
+  assert_true(az_json_token_is_text_equal(&token, AZ_SPAN_FROM_STR("empty")));
+  assert_int_equal(
+      az_json_document_get_next_sibling(&document, index, &index), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_json_document_get_next_sibling(&document, 0, &index), AZ_ERROR_ITEM_NOT_FOUND);
+
+  int32_t list = -1;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_find_property(&document, 0, AZ_SPAN_FROM_STR("list"), &list));
+  TEST_EXPECT_SUCCESS(az_json_document_get_first_child(&document, list, &index));
+  token = az_json_document_get_token(&document, index);
+  assert_true(az_span_is_content_equal(token.slice, AZ_SPAN_FROM_STR("1")));
+  TEST_EXPECT_SUCCESS(az_json_document_get_next_sibling(&document, index, &index));
+  assert_int_equal(az_json_document_get_token(&document, index).kind, AZ_JSON_TOKEN_BEGIN_ARRAY);
+  assert_int_equal(
+      az_json_document_get_first_child(&document, index, &index), AZ_ERROR_ITEM_NOT_FOUND);
+  TEST_EXPECT_SUCCESS(az_json_document_get_next_sibling(&document, index, &index));
+  TEST_EXPECT_SUCCESS(
+      az_json_document_find_property(&document, index, AZ_SPAN_FROM_STR("n\""), &index));
+  token = az_json_document_get_token(&document, index);
+  assert_true(az_json_token_is_text_equal(&token, AZ_SPAN_FROM_STR("v")));
+  TEST_EXPECT_SUCCESS(az_json_document_get_parent(&document, index, &index));
+  TEST_EXPECT_SUCCESS(az_json_document_get_parent(&document, index, &index));
+  assert_int_equal(index, list);
+
+  TEST_EXPECT_SUCCESS(
+      az_json_document_find_property(&document, 0, AZ_SPAN_FROM_STR("empty"), &index));
+  assert_int_equal(
+      az_json_document_get_first_child(&document, index, &index), AZ_ERROR_ITEM_NOT_FOUND);
+
+  // A single primitive value.
+  TEST_EXPECT_SUCCESS(
+      az_json_document_parse(&document, AZ_SPAN_FROM_STR(" \"a\" "), records, 1, NULL));
+  assert_int_equal(az_json_document_get_token_count(&document), 1);
+  token = az_json_document_get_token(&document, 0);
+  assert_true(az_json_token_is_text_equal(&token, AZ_SPAN_FROM_STR("a")));
+
+  assert_int_equal(
+      az_json_document_parse(&document, AZ_SPAN_FROM_STR("{\"a\":[}"), records, 25, NULL),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_document_parse(&document, AZ_SPAN_FROM_STR("[1,"), records, 25, NULL),
+      AZ_ERROR_UNEXPECTED_END);
+}
+
+static void test_json_push_reader(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      " {\"desired\" : {\"temp\\\"erature\":-12.5e+3, \"list\":[true,false,null,{}, 0]},"
+      "\"$version\":  123456 } \n");
+
+  // Feed the JSON in fragments of every size, reusing the same fragment buffer each time, and
+  // compare the tokens with those of a reader over the whole buffer.
+  for (int32_t fragment_size = 1; fragment_size <= az_span_size(json); fragment_size++)
+  {
+    uint8_t carry[32] = { 0 };
+    uint8_t fragment_buffer[128] = { 0 };
+    az_json_push_reader push_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(carry), NULL));
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+
+    int32_t fed = 0;
+    while (true)
+    {
+      az_result result = az_json_push_reader_next_token(&push_reader);
+      if (result == AZ_ERROR_UNEXPECTED_END)
+      {
+        assert_true(fed < az_span_size(json));
+        int32_t const size = az_span_size(json) - fed < fragment_size
+            ? az_span_size(json) - fed
+            : fragment_size;
+        az_span_copy(AZ_SPAN_FROM_BUFFER(fragment_buffer), az_span_slice(json, fed, fed + size));
+        fed += size;
+        TEST_EXPECT_SUCCESS(az_json_push_reader_feed(
+            &push_reader,
+            az_span_slice(AZ_SPAN_FROM_BUFFER(fragment_buffer), 0, size),
+            fed == az_span_size(json)));
+        continue;
+      }
+
+      assert_int_equal(result, az_json_reader_next_token(&reader));
+      if (result == AZ_ERROR_JSON_READER_DONE)
+      {
+        break;
+      }
+      TEST_EXPECT_SUCCESS(result);
+
+      uint8_t token_buffer[32] = { 0 };
+      az_span const token_text
+          = az_json_token_copy_into_span(&push_reader.token, AZ_SPAN_FROM_BUFFER(token_buffer));
+      assert_int_equal(push_reader.token.kind, reader.token.kind);
+      assert_int_equal(push_reader.token.size, reader.token.size);
+      int32_t const token_size = (int32_t)(az_span_ptr(token_text) - token_buffer);
+      assert_true(az_span_is_content_equal(
+          az_span_create(token_buffer, token_size), reader.token.slice));
+    }
+  }
+
+  {
+    // A number at the end of a fragment could continue within the next one.
+    uint8_t carry[8] = { 0 };
+    az_json_push_reader push_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(carry), NULL));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("[12"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(push_reader.token.kind, AZ_JSON_TOKEN_BEGIN_ARRAY);
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("34"), false));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR(" "), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(push_reader.token.kind, AZ_JSON_TOKEN_NUMBER);
+    int32_t value = 0;
+    TEST_EXPECT_SUCCESS(az_json_token_get_int32(&push_reader.token, &value));
+    assert_int_equal(value, 1234);
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+
+    // The JSON ends before the array does.
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_EMPTY, true));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+  }
+
+  {
+    // A top-level number is complete once the last fragment is provided.
+    uint8_t carry[8] = { 0 };
+    az_json_push_reader push_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(carry), NULL));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR(" 4"), false));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("2"), true));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_true(az_span_is_content_equal(push_reader.token.slice, AZ_SPAN_FROM_STR("2")));
+    assert_int_equal(push_reader.token.size, 2);
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_JSON_READER_DONE);
+  }
+
+  {
+    // A property name which straddles fragments can still be used once its value runs out of text.
+    uint8_t carry[8] = { 0 };
+    az_json_push_reader push_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(carry), NULL));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("{\"temp"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    TEST_EXPECT_SUCCESS(
+        az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("erature\":\"hi"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    az_json_token const property_name = push_reader.token;
+    assert_int_equal(property_name.kind, AZ_JSON_TOKEN_PROPERTY_NAME);
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+
+    char name[16] = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_token_get_string(&property_name, name, sizeof(name), NULL));
+    assert_string_equal(name, "temperature");
+    assert_true(az_json_token_is_text_equal(&property_name, AZ_SPAN_FROM_STR("temperature")));
+
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("gh\"}"), true));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_true(az_json_token_is_text_equal(&push_reader.token, AZ_SPAN_FROM_STR("high")));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(push_reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+
+    // The start of the property name is kept along with that of its value.
+    uint8_t small_carry[7] = { 0 };
+    TEST_EXPECT_SUCCESS(
+        az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(small_carry), NULL));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("{\"temp"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_END);
+    TEST_EXPECT_SUCCESS(
+        az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("erature\":\"hi"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_NOT_ENOUGH_SPACE);
+  }
+
+  {
+    // The carry-over buffer must fit the start of a token which straddles fragments.
+    uint8_t carry[4] = { 0 };
+    az_json_push_reader push_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(carry), NULL));
+    TEST_EXPECT_SUCCESS(
+        az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("[\"abcdef"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_NOT_ENOUGH_SPACE);
+  }
+
+  {
+    uint8_t carry[4] = { 0 };
+    az_json_push_reader push_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_push_reader_init(&push_reader, AZ_SPAN_FROM_BUFFER(carry), NULL));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&push_reader, AZ_SPAN_FROM_STR("[tx"), false));
+    TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&push_reader));
+    assert_int_equal(az_json_push_reader_next_token(&push_reader), AZ_ERROR_UNEXPECTED_CHAR);
+  }
+}
+
+static void test_json_skip_children_without_validation(void** state)
+{
+  (void)state;
+
+  az_json_reader_options options = az_json_reader_options_default();
+  options.skip_children_without_validation = true;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      "{\"a\":{\"b\":[1,2,{\"c\":\"}]\\\\\\\"}\"}],\"d\\\\\":\"\\\\\"},"
+      "\"long\":[\"0123456789012345678901234567890123456789012345678901234567890123\\\"]]]\","
+      "{\"x\":[[[[[[[[]]]]]]]],\"y\":\"\\\\\\\\\\\\\\\"{{{\"},[],{}],"
+      "\"e\":{\"f\":[{},{\"g\":\"]\"}]}, \"h\": [ ] }");
+
+  // Skipping from every start of an object or array leaves the reader in the same state as
+  // reading every nested token, for a contiguous buffer and for every split into two segments.
+  for (int32_t split = 0; split < az_span_size(json); split++)
+  {
+    az_span segments[2] = { az_span_slice(json, 0, split), az_span_slice_to_end(json, split) };
+
+    for (int32_t skip_at = 0;; skip_at++)
+    {
+      az_json_reader reader = { 0 };
+      az_json_reader fast_reader = { 0 };
+      if (split == 0)
+      {
+        TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+        TEST_EXPECT_SUCCESS(az_json_reader_init(&fast_reader, json, &options));
+      }
+      else
+      {
+        TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, segments, 2, NULL));
+        TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&fast_reader, segments, 2, &options));
+      }
+
+      // Move to the next start of an object or array.
+      int32_t begin_count = 0;
+      az_result result = AZ_OK;
+      while (az_result_succeeded(result = az_json_reader_next_token(&reader)))
+      {
+        TEST_EXPECT_SUCCESS(az_json_reader_next_token(&fast_reader));
+        if ((reader.token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT
+             || reader.token.kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
+            && begin_count++ == skip_at)
+        {
+          break;
+        }
+      }
+
+      if (result == AZ_ERROR_JSON_READER_DONE)
+      {
+        break;
+      }
+
+      TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&reader));
+      TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&fast_reader));
+      assert_int_equal(fast_reader.token.kind, reader.token.kind);
+      assert_ptr_equal(az_span_ptr(fast_reader.token.slice), az_span_ptr(reader.token.slice));
+      assert_int_equal(az_span_size(fast_reader.token.slice), 1);
+      assert_int_equal(fast_reader._internal.bytes_consumed, reader._internal.bytes_consumed);
+      assert_int_equal(fast_reader._internal.buffer_index, reader._internal.buffer_index);
+      assert_int_equal(
+          fast_reader._internal.bit_stack._internal.current_depth,
+          reader._internal.bit_stack._internal.current_depth);
+
+      // Both readers continue identically.
+      while (az_result_succeeded(result = az_json_reader_next_token(&reader)))
+      {
+        TEST_EXPECT_SUCCESS(az_json_reader_next_token(&fast_reader));
+        assert_ptr_equal(az_span_ptr(fast_reader.token.slice), az_span_ptr(reader.token.slice));
+      }
+      assert_int_equal(result, AZ_ERROR_JSON_READER_DONE);
+      assert_int_equal(az_json_reader_next_token(&fast_reader), AZ_ERROR_JSON_READER_DONE);
+    }
+  }
+
+  az_json_reader reader = { 0 };
+
+  // The skipped JSON text isn't validated.
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":[tru, 1.2.3 :, ,],\"b\":1}"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_ARRAY);
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_true(az_json_token_is_text_equal(&reader.token, AZ_SPAN_FROM_STR("b")));
+
+  // The end must still match the start.
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("[{}}"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":\"}\""), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_UNEXPECTED_END);
+}
+
+static void test_json_validate_utf8(void** state)
+{
+  (void)state;
+
+  az_json_reader_options options = az_json_reader_options_default();
+  options.validate_utf8 = true;
+
+  // Characters of each UTF-8 encoding length, including the smallest and largest of each.
+  az_span const valid = AZ_SPAN_FROM_STR("{\"n\\u00e9\xC3\xA9\":\"\x7F\xC2\x80\xDF\xBF\xE0\xA0\x80"
+                                         "\xED\x9F\xBF\xEE\x80\x80\xEF\xBF\xBF\xF0\x90\x80\x80"
+                                         "\xF4\x8F\xBF\xBF\\n\xE2\x82\xAC\"}");
+
+  // Every way of splitting the JSON in two, each multi-byte sequence straddling the buffers.
+  for (int32_t split = 1; split < az_span_size(valid); split++)
+  {
+    az_span buffers[2] = { az_span_slice(valid, 0, split), az_span_slice_to_end(valid, split) };
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers, 2, &options));
+    az_result result = AZ_OK;
+    while (az_result_succeeded(result = az_json_reader_next_token(&reader)))
+    {
+    }
+    assert_int_equal(result, AZ_ERROR_JSON_READER_DONE);
+  }
+
+  az_span const invalid_strings[] = {
+    AZ_SPAN_FROM_STR("\"\x80\""), // A continuation byte without a lead byte.
+    AZ_SPAN_FROM_STR("\"\xC0\xAF\""), // An overlong encoding of '/'.
+    AZ_SPAN_FROM_STR("\"\xE0\x9F\xBF\""), // An overlong encoding of U+07FF.
+    AZ_SPAN_FROM_STR("\"\xF0\x8F\xBF\xBF\""), // An overlong encoding of U+FFFF.
+    AZ_SPAN_FROM_STR("\"\xED\xA0\x80\""), // The surrogate U+D800.
+    AZ_SPAN_FROM_STR("\"\xF4\x90\x80\x80\""), // Past U+10FFFF.
+    AZ_SPAN_FROM_STR("\"\xF5\x80\x80\x80\""),
+    AZ_SPAN_FROM_STR("\"\xFF\""),
+    AZ_SPAN_FROM_STR("\"a\xC3\""), // A sequence cut short by the end of the string.
+    AZ_SPAN_FROM_STR("\"\xE2\x82\\n\""), // A sequence cut short by an escape.
+    AZ_SPAN_FROM_STR("\"\xC3 \""),
+  };
+
+  for (size_t i = 0; i < sizeof(invalid_strings) / sizeof(invalid_strings[0]); i++)
+  {
+    az_span const json = invalid_strings[i];
+    az_json_reader reader = { 0 };
+
+    // Without validation, the bytes are read as they are.
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, &options));
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+    // The writer uses the same validation, for the text between the quotes.
+    az_json_writer_options writer_options = az_json_writer_options_default();
+    writer_options.validate_utf8 = true;
+    az_span const text = az_span_slice(json, 1, az_span_size(json) - 1);
+
+    uint8_t buffer[32] = { 0 };
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), &writer_options));
+    assert_int_equal(az_json_writer_append_string(&writer, text), AZ_ERROR_UNEXPECTED_CHAR);
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+    assert_int_equal(az_json_writer_append_property_name(&writer, text), AZ_ERROR_UNEXPECTED_CHAR);
+  }
+
+  uint8_t buffer[128] = { 0 };
+  az_json_writer_options writer_options = az_json_writer_options_default();
+  writer_options.validate_utf8 = true;
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), &writer_options));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("\xC3\xA9")));
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_append_string(&writer, AZ_SPAN_FROM_STR("\xF0\x9F\x98\x80 and more text")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+  az_span_to_str((char*)buffer, 128, az_json_writer_get_bytes_used_in_destination(&writer));
+  assert_string_equal(buffer, "{\"\xC3\xA9\":\"\xF0\x9F\x98\x80 and more text\"}");
+}
+
+// Checks that the typed getters return the same results for a number token whose value was
+// captured by the reader, as for the same token without it.
+static void _az_json_expect_same_number_results(
+    az_json_token const* captured_token,
+    az_json_token const* token)
+{
+  int32_t i32_expected = 0;
+  int32_t i32_actual = 0;
+  assert_int_equal(
+      az_json_token_get_int32(captured_token, &i32_actual),
+      az_json_token_get_int32(token, &i32_expected));
+  assert_int_equal(i32_actual, i32_expected);
+
+  int64_t i64_expected = 0;
+  int64_t i64_actual = 0;
+  assert_int_equal(
+      az_json_token_get_int64(captured_token, &i64_actual),
+      az_json_token_get_int64(token, &i64_expected));
+  assert_true(i64_actual == i64_expected);
+
+  uint32_t u32_expected = 0;
+  uint32_t u32_actual = 0;
+  assert_int_equal(
+      az_json_token_get_uint32(captured_token, &u32_actual),
+      az_json_token_get_uint32(token, &u32_expected));
+  assert_int_equal(u32_actual, u32_expected);
+
+  uint64_t u64_expected = 0;
+  uint64_t u64_actual = 0;
+  assert_int_equal(
+      az_json_token_get_uint64(captured_token, &u64_actual),
+      az_json_token_get_uint64(token, &u64_expected));
+  assert_true(u64_actual == u64_expected);
+
+  double d_expected = 0;
+  double d_actual = 0;
+  assert_int_equal(
+      az_json_token_get_double(captured_token, &d_actual),
+      az_json_token_get_double(token, &d_expected));
+  assert_true(_is_double_equal(d_actual, d_expected, 1e-9));
+  assert_int_equal(signbit(d_actual), signbit(d_expected));
+}
+
+static void test_json_reader_capture_number_values(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      "[0,-0,7,-7,2147483647,2147483648,-2147483648,-2147483649,4294967295,4294967296,"
+      "9223372036854775807,9223372036854775808,-9223372036854775808,-9223372036854775809,"
+      "18446744073709551615,18446744073709551616,1234567890123456789,-12345678901234567890,"
+      "9007199254740991,9007199254740993,1.5,-2e3,0.0,10E-1,-0e0,100000000000000000000000]");
+  int32_t const json_size = az_span_size(json);
+
+  az_json_reader_options captured_options = az_json_reader_options_default();
+  captured_options.capture_number_values = true;
+
+  // The number tokens are the same, whether the JSON is contiguous or split anywhere.
+  for (int32_t split = 0; split < json_size; split++)
+  {
+    az_span segments[2] = { json, AZ_SPAN_EMPTY };
+    segments[0] = az_span_slice(json, 0, split == 0 ? json_size : split);
+    segments[1] = az_span_slice_to_end(json, split);
+
+    az_json_reader captured_reader = { 0 };
+    az_json_reader reader = { 0 };
+    int32_t const segments_size = split == 0 ? 1 : 2;
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(
+        &captured_reader, segments, segments_size, &captured_options));
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, segments, segments_size, NULL));
+
+    int32_t number_count = 0;
+    while (az_result_succeeded(az_json_reader_next_token(&reader)))
+    {
+      TEST_EXPECT_SUCCESS(az_json_reader_next_token(&captured_reader));
+      assert_int_equal(captured_reader.token.kind, reader.token.kind);
+      if (reader.token.kind == AZ_JSON_TOKEN_NUMBER)
+      {
+        assert_true(captured_reader.token._internal.number_flags != 0);
+        assert_int_equal(reader.token._internal.number_flags, 0);
+        _az_json_expect_same_number_results(&captured_reader.token, &reader.token);
+        number_count++;
+      }
+    }
+    assert_int_equal(number_count, 26);
+  }
+
+  // A number that is the whole JSON text is also captured.
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("-42"), &captured_options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  int32_t value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_int32(&reader.token, &value));
+  assert_int_equal(value, -42);
+  uint32_t unsigned_value = 0;
+  assert_int_equal(
+      az_json_token_get_uint32(&reader.token, &unsigned_value), AZ_ERROR_UNEXPECTED_CHAR);
+}
+
+static void test_json_reader_capture_fractional_numbers(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      "[23.45,-0.5,0.001,-0.0,1.25e2,7.5E-3,123456789012345.6,0.1234567890123456789,"
+      "1234567890.1234567890123,5e-324,1.7976931348623157e308,1e0000000000000000000022,"
+      "4.35e-22,9007199254740993.0,3.0e+22,12.5e-23]");
+  int32_t const json_size = az_span_size(json);
+
+  az_json_reader_options captured_options = az_json_reader_options_default();
+  captured_options.capture_number_values = true;
+
+  // Whichever way the digits are captured, the same double is returned as when parsing the text.
+  for (int32_t split = 0; split < json_size; split++)
+  {
+    az_span segments[2] = { json, AZ_SPAN_EMPTY };
+    segments[0] = az_span_slice(json, 0, split == 0 ? json_size : split);
+    segments[1] = az_span_slice_to_end(json, split);
+
+    az_json_reader captured_reader = { 0 };
+    az_json_reader reader = { 0 };
+    int32_t const segments_size = split == 0 ? 1 : 2;
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(
+        &captured_reader, segments, segments_size, &captured_options));
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, segments, segments_size, NULL));
+
+    int32_t number_count = 0;
+    while (az_result_succeeded(az_json_reader_next_token(&reader)))
+    {
+      TEST_EXPECT_SUCCESS(az_json_reader_next_token(&captured_reader));
+      if (reader.token.kind == AZ_JSON_TOKEN_NUMBER)
+      {
+        double expected = 0;
+        double actual = 0;
+        TEST_EXPECT_SUCCESS(az_json_token_get_double(&reader.token, &expected));
+        TEST_EXPECT_SUCCESS(az_json_token_get_double(&captured_reader.token, &actual));
+        assert_memory_equal(&actual, &expected, sizeof(double));
+        number_count++;
+      }
+    }
+    assert_int_equal(number_count, 16);
+  }
+
+  // The digits before the exponent are counted, and the decimal point and exponent scale them.
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("-12.345e-2"), &captured_options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token._internal.number_digit_count, 5);
+  assert_int_equal(reader.token._internal.number_exponent, -5);
+  assert_true(reader.token._internal.number_magnitude == 12345);
+  double value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_double(&reader.token, &value));
+  assert_true(value == -0.12345);
+}
+
+static void test_json_template(void** state)
+{
+  (void)state;
+
+  uint8_t template_buffer[128] = { 0 };
+  az_json_template_slot slots[6] = { 0 };
+  az_json_template json_template = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_BUFFER(template_buffer), slots, 6, NULL));
+
+  az_json_writer* const writer = az_json_template_get_writer(&json_template);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("temperature")));
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(&json_template, AZ_JSON_BIND_DOUBLE, 2));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("humidity")));
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(
+      &json_template, AZ_JSON_BIND_DOUBLE, AZ_JSON_BIND_DOUBLE_SHORTEST));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("ts")));
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(&json_template, AZ_JSON_BIND_STRING, 0));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(writer, AZ_SPAN_FROM_STR("tags")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(writer));
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(&json_template, AZ_JSON_BIND_BOOLEAN, 0));
+  // The fractional digits are ignored for the types other than doubles.
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(&json_template, AZ_JSON_BIND_INT32, 100));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_string(writer, AZ_SPAN_FROM_STR("fixed")));
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(&json_template, AZ_JSON_BIND_INT64, 0));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(writer));
+
+  // There is no room for another slot.
+  assert_int_equal(
+      az_json_template_append_slot(&json_template, AZ_JSON_BIND_UINT32, 0),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(writer));
+
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(writer),
+      AZ_SPAN_FROM_STR("{\"temperature\":0,\"humidity\":0,\"ts\":\"\",\"tags\":[false,0,"
+                       "\"fixed\",0]}")));
+
+  // The template is filled in the same way, any number of times.
+  for (int32_t i = 0; i < 2; i++)
+  {
+    uint8_t buffer[128] = { 0 };
+    az_json_template_writer template_writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_template_writer_init(
+        &template_writer, &json_template, AZ_SPAN_FROM_BUFFER(buffer)));
+    TEST_EXPECT_SUCCESS(az_json_template_writer_append_double(&template_writer, 21.25));
+    TEST_EXPECT_SUCCESS(az_json_template_writer_append_double(&template_writer, 0.1 + i));
+    TEST_EXPECT_SUCCESS(az_json_template_writer_append_string(
+        &template_writer, AZ_SPAN_FROM_STR("2021-03-09T\"12\"")));
+    TEST_EXPECT_SUCCESS(az_json_template_writer_append_bool(&template_writer, i == 0));
+    TEST_EXPECT_SUCCESS(az_json_template_writer_append_int32(&template_writer, -42 * i));
+    TEST_EXPECT_SUCCESS(az_json_template_writer_append_int64(&template_writer, INT64_MIN));
+
+    az_span json = AZ_SPAN_EMPTY;
+    TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&template_writer, &json));
+    assert_true(az_span_is_content_equal(
+        json,
+        i == 0 ? AZ_SPAN_FROM_STR("{\"temperature\":21.25,\"humidity\":0.1,"
+                                  "\"ts\":\"2021-03-09T\\\"12\\\"\",\"tags\":[true,0,\"fixed\","
+                                  "-9223372036854775808]}")
+               : AZ_SPAN_FROM_STR("{\"temperature\":21.25,\"humidity\":1.1,"
+                                  "\"ts\":\"2021-03-09T\\\"12\\\"\",\"tags\":[false,-42,\"fixed\","
+                                  "-9223372036854775808]}")));
+  }
+
+  // Every part of the JSON must fit within the destination buffer.
+  uint8_t small_buffer[30] = { 0 };
+  for (int32_t size = 1; size < 30; size++)
+  {
+    az_json_template_writer template_writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_template_writer_init(
+        &template_writer, &json_template, az_span_create(small_buffer, size)));
+
+    az_result result = az_json_template_writer_append_double(&template_writer, 21.25);
+    if (az_result_succeeded(result))
+    {
+      result = az_json_template_writer_append_double(&template_writer, 0.1);
+    }
+    if (az_result_succeeded(result))
+    {
+      result = az_json_template_writer_append_string(&template_writer, AZ_SPAN_FROM_STR("\n"));
+    }
+    assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  }
+
+  // A double slot without fractional digits writes none, as az_json_writer_append_double() does.
+  az_json_template whole_template = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_template_init(
+      &whole_template, AZ_SPAN_FROM_BUFFER(template_buffer), slots, 6, NULL));
+  TEST_EXPECT_SUCCESS(az_json_template_append_slot(&whole_template, AZ_JSON_BIND_DOUBLE, 0));
+
+  uint8_t whole_buffer[8] = { 0 };
+  az_json_template_writer whole_writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_template_writer_init(
+      &whole_writer, &whole_template, AZ_SPAN_FROM_BUFFER(whole_buffer)));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_double(&whole_writer, 21.25));
+  az_span whole_json = AZ_SPAN_EMPTY;
+  TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&whole_writer, &whole_json));
+  assert_true(az_span_is_content_equal(whole_json, AZ_SPAN_FROM_STR("21")));
+}
+
+static void test_json_transform(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      "{\"id\":\"dev-1\",\"secret\":\"x\",\"telemetry\":{\"temp\":21.5,\"hum\":40,"
+      "\"raw\":[1, 2, {\"a\":1}]},\"tags\":[\"a\",{\"b\":2},\"c\"],\"n\\\"q\":null}");
+  uint8_t buffer[256] = { 0 };
+  {
+    az_json_transform_rule const rules[] = {
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/secret"), .action = AZ_JSON_TRANSFORM_DROP },
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/telemetry/temp"),
+        .action = AZ_JSON_TRANSFORM_RENAME,
+        .new_name = AZ_SPAN_LITERAL_FROM_STR("temperature") },
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/tags/1"), .action = AZ_JSON_TRANSFORM_DROP },
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/tags/2"),
+        .action = AZ_JSON_TRANSFORM_RENAME,
+        .new_name = AZ_SPAN_LITERAL_FROM_STR("ignored") },
+    };
+
+    az_json_reader_options options = az_json_reader_options_default();
+    options.skip_children_without_validation = true;
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, &options));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+
+    // The transformed value is wrapped within an envelope.
+    TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("body")));
+    TEST_EXPECT_SUCCESS(az_json_transform(&reader, &writer, rules, 4));
+    TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("{\"body\":{\"id\":\"dev-1\",\"telemetry\":{\"temperature\":21.5,"
+                         "\"hum\":40,\"raw\":[1, 2, {\"a\":1}]},\"tags\":[\"a\",\"c\"],"
+                         "\"n\\\"q\":null}}")));
+  }
+  {
+    // Only the values referred to by the rules which keep them are left, along with their parents.
+    az_json_transform_rule const rules[] = {
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/telemetry/hum"), .action = AZ_JSON_TRANSFORM_KEEP },
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/id"), .action = AZ_JSON_TRANSFORM_KEEP },
+      { .path = AZ_SPAN_LITERAL_FROM_STR("/tags/5/b"), .action = AZ_JSON_TRANSFORM_KEEP },
+    };
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+    TEST_EXPECT_SUCCESS(az_json_transform(&reader, &writer, rules, 3));
+
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("{\"id\":\"dev-1\",\"telemetry\":{\"hum\":40},\"tags\":[]}")));
+  }
+  {
+    // Without rules, the value is copied as is.
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(
+        az_json_reader_init(&reader, AZ_SPAN_FROM_STR(" { \"a\" : [1, \"\"] } "), NULL));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+    TEST_EXPECT_SUCCESS(az_json_transform(&reader, &writer, NULL, 0));
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("{ \"a\" : [1, \"\"] }")));
+
+    // Invalid JSON is still reported.
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":[1,}"), NULL));
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+    assert_int_equal(az_json_transform(&reader, &writer, NULL, 0), AZ_ERROR_UNEXPECTED_CHAR);
+  }
+}
+
+static void test_json_merge_patch(void** state)
+{
+  (void)state;
+
+  // The examples from RFC 7396, Appendix A.
+  struct
+  {
+    az_span base;
+    az_span patch;
+    az_span expected;
+  } const cases[] = {
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"c\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"c\"}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"b\":\"c\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\",\"b\":\"c\"}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":null}"),
+      AZ_SPAN_LITERAL_FROM_STR("{}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\",\"b\":\"c\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":null}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"b\":\"c\"}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":[\"b\"]}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"c\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"c\"}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"c\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":[\"b\"]}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":[\"b\"]}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":{\"b\":\"c\"}}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":{\"b\":\"d\",\"c\":null}}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":{\"b\":\"d\"}}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":[{\"b\":\"c\"}]}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":[1]}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":[1]}") },
+    { AZ_SPAN_LITERAL_FROM_STR("[\"a\",\"b\"]"),
+      AZ_SPAN_LITERAL_FROM_STR("[\"c\",\"d\"]"),
+      AZ_SPAN_LITERAL_FROM_STR("[\"c\",\"d\"]") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("[\"c\"]"),
+      AZ_SPAN_LITERAL_FROM_STR("[\"c\"]") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"foo\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("null"),
+      AZ_SPAN_LITERAL_FROM_STR("null") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"foo\"}"),
+      AZ_SPAN_LITERAL_FROM_STR("\"bar\""),
+      AZ_SPAN_LITERAL_FROM_STR("\"bar\"") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"e\":null}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":1}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"e\":null,\"a\":1}") },
+    { AZ_SPAN_LITERAL_FROM_STR("[1,2]"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\",\"c\":null}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":\"b\"}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":{\"bb\":{\"ccc\":null}}}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\":{\"bb\":{}}}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\\u0062\":1,\"c\":2}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"ab\":3}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\\u0062\":3,\"c\":2}") },
+    { AZ_SPAN_LITERAL_FROM_STR("{\"a\\/b\":1,\"c\":2}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\\u002fb\":3}"),
+      AZ_SPAN_LITERAL_FROM_STR("{\"a\\/b\":3,\"c\":2}") },
+  };
+
+  uint8_t buffer[128] = { 0 };
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+  {
+    az_json_reader base_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&base_reader, cases[i].base, NULL));
+    az_json_reader patch_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&patch_reader, cases[i].patch, NULL));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_merge_patch_apply(&base_reader, &patch_reader, &writer));
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer), cases[i].expected));
+  }
+
+  az_span const source = AZ_SPAN_FROM_STR(
+      "{\"a\":1,\"b\":{\"c\":2,\"d\":[1,2]},\"e\":\"x\",\"f\":{\"g\":[true]}}");
+  az_span const target = AZ_SPAN_FROM_STR(
+      "{\"a\":1,\"b\":{\"c\":3,\"d\":[1,2]},\"f\":{\"g\":[true]},\"h\":true}");
+  {
+    // Only what changed is within the patch, which turns the source into the target.
+    az_json_reader source_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&source_reader, source, NULL));
+    az_json_reader target_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&target_reader, target, NULL));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_merge_patch_create(&source_reader, &target_reader, &writer));
+    az_span const patch = az_json_writer_get_bytes_used_in_destination(&writer);
+    assert_true(az_span_is_content_equal(
+        patch, AZ_SPAN_FROM_STR("{\"e\":null,\"b\":{\"c\":3},\"h\":true}")));
+
+    uint8_t patched_buffer[128] = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&source_reader, source, NULL));
+    az_json_reader patch_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&patch_reader, patch, NULL));
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(patched_buffer), NULL));
+    TEST_EXPECT_SUCCESS(az_json_merge_patch_apply(&source_reader, &patch_reader, &writer));
+    assert_true(
+        az_span_is_content_equal(az_json_writer_get_bytes_used_in_destination(&writer), target));
+  }
+  {
+    // Identical objects give an empty patch.
+    az_json_reader source_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&source_reader, source, NULL));
+    az_json_reader target_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&target_reader, source, NULL));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_merge_patch_create(&source_reader, &target_reader, &writer));
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer), AZ_SPAN_FROM_STR("{}")));
+    assert_int_equal(target_reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+  }
+  {
+    // Names escaped in different ways are still the same name.
+    az_json_reader source_reader = { 0 };
+    TEST_EXPECT_SUCCESS(
+        az_json_reader_init(&source_reader, AZ_SPAN_FROM_STR("{\"a\\/b\":1,\"\\u00e9\":2}"), NULL));
+    az_json_reader target_reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(
+        &target_reader, AZ_SPAN_FROM_STR("{\"a\\u002fb\":1,\"\\u00E9\":3}"), NULL));
+    az_json_writer writer = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+
+    TEST_EXPECT_SUCCESS(az_json_merge_patch_create(&source_reader, &target_reader, &writer));
+    assert_true(az_span_is_content_equal(
+        az_json_writer_get_bytes_used_in_destination(&writer),
+        AZ_SPAN_FROM_STR("{\"\\u00E9\":3}")));
+  }
+}
+
+static az_result _az_json_array_read_id(
+    az_json_reader* ref_json_reader,
+    int32_t element_index,
+    void* user_context)
+{
+  int32_t* const ids = (int32_t*)user_context;
+
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  while (ref_json_reader->token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    bool const is_id = az_json_token_is_text_equal(&ref_json_reader->token, AZ_SPAN_FROM_STR("id"));
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    if (is_id)
+    {
+      _az_RETURN_IF_FAILED(az_json_token_get_int32(&ref_json_reader->token, &ids[element_index]));
+    }
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_json_reader));
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  }
+
+  return AZ_OK;
+}
+
+// Runs the tasks in reverse order, as a worker pool might complete them.
+static void _az_json_array_run_tasks_in_reverse(
+    void* pool_context,
+    az_json_array_task_fn task,
+    void* task_context,
+    int32_t number_of_tasks)
+{
+  (*(int32_t*)pool_context)++;
+  for (int32_t i = number_of_tasks - 1; i >= 0; i--)
+  {
+    task(task_context, i);
+  }
+}
+
+static void test_json_array_split(void** state)
+{
+  (void)state;
+
+  // Commas, brackets and escaped quotes within strings don't split the array.
+  uint8_t json_buffer[2048] = { 0 };
+  az_span remainder = az_span_copy(AZ_SPAN_FROM_BUFFER(json_buffer), AZ_SPAN_FROM_STR(" [ "));
+  for (int32_t i = 0; i < 24; i++)
+  {
+    if (i > 0)
+    {
+      remainder = az_span_copy_u8(remainder, ',');
+    }
+    remainder = az_span_copy(
+        remainder,
+        AZ_SPAN_FROM_STR("\n{\"name\":\"a, [b] \\\"}\\\\\",\"values\":[1,{\"x\":[2,3]}],\"id\":"));
+    TEST_EXPECT_SUCCESS(az_span_i32toa(remainder, i * 10, &remainder));
+    remainder = az_span_copy_u8(remainder, '}');
+  }
+  remainder = az_span_copy(remainder, AZ_SPAN_FROM_STR("\n] "));
+  az_span const json = az_span_slice(
+      AZ_SPAN_FROM_BUFFER(json_buffer), 0, (int32_t)sizeof(json_buffer) - az_span_size(remainder));
+
+  az_json_array_part parts[4];
+  int32_t number_of_parts = 0;
+  TEST_EXPECT_SUCCESS(az_json_array_split(json, parts, 4, &number_of_parts));
+  assert_int_equal(number_of_parts, 4);
+
+  // The parts are about the same size, and cover all the elements in order.
+  int32_t next_element_index = 0;
+  for (int32_t i = 0; i < number_of_parts; i++)
+  {
+    assert_int_equal(parts[i].first_element_index, next_element_index);
+    assert_true(parts[i].number_of_elements >= 5 && parts[i].number_of_elements <= 7);
+    assert_int_equal(az_span_ptr(parts[i].elements)[0], '{');
+    next_element_index += parts[i].number_of_elements;
+  }
+  assert_int_equal(next_element_index, 24);
+
+  int32_t ids[24] = { 0 };
+  int32_t pool_calls = 0;
+  TEST_EXPECT_SUCCESS(az_json_array_parse_parts(
+      parts,
+      number_of_parts,
+      NULL,
+      _az_json_array_read_id,
+      ids,
+      _az_json_array_run_tasks_in_reverse,
+      &pool_calls));
+  assert_int_equal(pool_calls, 1);
+  for (int32_t i = 0; i < 24; i++)
+  {
+    assert_int_equal(ids[i], i * 10);
+  }
+  for (int32_t i = 0; i < number_of_parts; i++)
+  {
+    assert_int_equal(parts[i].number_of_elements, 0);
+  }
+
+  {
+    // There are never more parts than elements.
+    az_span const small = AZ_SPAN_FROM_STR("[{\"id\":1}, {\"id\":2}]");
+    TEST_EXPECT_SUCCESS(az_json_array_split(small, parts, 4, &number_of_parts));
+    assert_int_equal(number_of_parts, 2);
+    assert_true(az_span_is_content_equal(parts[1].elements, AZ_SPAN_FROM_STR("{\"id\":2}")));
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_array_part_next_element(&parts[1], NULL, &reader));
+    assert_int_equal(parts[1].first_element_index, 2);
+    assert_int_equal(
+        az_json_array_part_next_element(&parts[1], NULL, &reader), AZ_ERROR_JSON_READER_DONE);
+  }
+
+  TEST_EXPECT_SUCCESS(az_json_array_split(AZ_SPAN_FROM_STR(" [ ] "), parts, 4, &number_of_parts));
+  assert_int_equal(number_of_parts, 0);
+  TEST_EXPECT_SUCCESS(
+      az_json_array_parse_parts(parts, 0, NULL, _az_json_array_read_id, ids, NULL, NULL));
+
+  assert_int_equal(
+      az_json_array_split(AZ_SPAN_FROM_STR("{\"a\":1}"), parts, 4, &number_of_parts),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_array_split(AZ_SPAN_FROM_STR("[1,2} "), parts, 4, &number_of_parts),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_array_split(AZ_SPAN_FROM_STR("[1,\"]\""), parts, 4, &number_of_parts),
+      AZ_ERROR_UNEXPECTED_END);
+  assert_int_equal(
+      az_json_array_split(AZ_SPAN_FROM_STR("[1] 2"), parts, 4, &number_of_parts),
+      AZ_ERROR_UNEXPECTED_CHAR);
+
+  {
+    // The elements are only validated when read, and the first part to fail is reported.
+    az_span const invalid = AZ_SPAN_FROM_STR("[{\"id\":1},{\"id\":},{\"id\":3},{\"id\":4,}]");
+    TEST_EXPECT_SUCCESS(az_json_array_split(invalid, parts, 4, &number_of_parts));
+    assert_int_equal(number_of_parts, 3);
+    assert_int_equal(
+        az_json_array_parse_parts(
+            parts, number_of_parts, NULL, _az_json_array_read_id, ids, NULL, NULL),
+        AZ_ERROR_UNEXPECTED_CHAR);
+    assert_int_equal(parts[0].result, AZ_ERROR_UNEXPECTED_CHAR);
+    assert_int_equal(parts[1].result, AZ_OK);
+    assert_int_equal(parts[2].result, AZ_ERROR_UNEXPECTED_CHAR);
+    assert_int_equal(ids[0], 1);
+    assert_int_equal(ids[2], 3);
+  }
+}
+
+static void test_json_lines_reader(void** state)
+{
+  (void)state;
+
+  az_span const json_lines = AZ_SPAN_FROM_STR("{\"id\":0,\"name\":\"a long enough record\"}\n"
+                                              "\n"
+                                              "  {\"id\":1}\r\n"
+                                              " \t\r\n"
+                                              "[2]\n"
+                                              "3");
+
+  az_json_lines_reader lines_reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_init(&lines_reader, json_lines, 0, true, NULL));
+
+  int32_t offsets[4] = { 0 };
+  for (int32_t i = 0; i < 4; i++)
+  {
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_lines_reader_next_record(&lines_reader, &reader));
+    offsets[i] = az_json_lines_reader_get_offset(&lines_reader);
+
+    // Each record is read in place, without the whitespace around it.
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&reader));
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+    assert_true(az_span_ptr(reader._internal.json_buffer) >= az_span_ptr(json_lines));
+    assert_true(
+        az_span_ptr(reader._internal.json_buffer) < az_span_ptr(json_lines) + offsets[i]);
+  }
+
+  assert_int_equal(offsets[0], 39);
+  assert_int_equal(offsets[3], az_span_size(json_lines));
+
+  az_json_reader reader = { 0 };
+  assert_int_equal(
+      az_json_lines_reader_next_record(&lines_reader, &reader), AZ_ERROR_JSON_READER_DONE);
+  assert_int_equal(az_json_lines_reader_get_offset(&lines_reader), az_span_size(json_lines));
+
+  // Reading resumes from the offset following a record.
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_init(&lines_reader, json_lines, offsets[1], true, NULL));
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_next_record(&lines_reader, &reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_BEGIN_ARRAY);
+  assert_int_equal(az_json_lines_reader_get_offset(&lines_reader), offsets[2]);
+
+  TEST_EXPECT_SUCCESS(
+      az_json_lines_reader_init(&lines_reader, AZ_SPAN_FROM_STR("\r\n"), 0, true, NULL));
+  assert_int_equal(
+      az_json_lines_reader_next_record(&lines_reader, &reader), AZ_ERROR_JSON_READER_DONE);
+
+  // A window which isn't final holds back its unterminated last line, and the next window resumes
+  // from the start of it.
+  int32_t const cut_record_offset = offsets[2] - 4;
+  az_span const window = az_span_slice(json_lines, 0, cut_record_offset + 2);
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_init(&lines_reader, window, offsets[1], false, NULL));
+  assert_int_equal(
+      az_json_lines_reader_next_record(&lines_reader, &reader), AZ_ERROR_UNEXPECTED_END);
+  assert_int_equal(az_json_lines_reader_get_offset(&lines_reader), cut_record_offset);
+  assert_int_equal(
+      az_json_lines_reader_next_record(&lines_reader, &reader), AZ_ERROR_UNEXPECTED_END);
+
+  az_span const next_window = az_span_slice_to_end(json_lines, cut_record_offset);
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_init(&lines_reader, next_window, 0, true, NULL));
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_next_record(&lines_reader, &reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_BEGIN_ARRAY);
+  assert_int_equal(az_json_lines_reader_get_offset(&lines_reader), 4);
+
+  // A window which isn't final, ending with a line ending, has no record held back.
+  TEST_EXPECT_SUCCESS(
+      az_json_lines_reader_init(&lines_reader, AZ_SPAN_FROM_STR("[0]\n"), 0, false, NULL));
+  TEST_EXPECT_SUCCESS(az_json_lines_reader_next_record(&lines_reader, &reader));
+  assert_int_equal(
+      az_json_lines_reader_next_record(&lines_reader, &reader), AZ_ERROR_JSON_READER_DONE);
+  assert_int_equal(az_json_lines_reader_get_offset(&lines_reader), 4);
+}
+
+typedef struct
+{
+  bool enabled;
+  int32_t count;
+  uint32_t limit;
+  int64_t timestamp;
+  double temperature;
+  az_json_bind_string name;
+} _az_json_bind_test_struct;
+
+static az_json_bind_field const _az_json_bind_test_fields[] = {
+  { .name = AZ_SPAN_LITERAL_FROM_STR("enabled"),
+    .type = AZ_JSON_BIND_BOOLEAN,
+    .offset = offsetof(_az_json_bind_test_struct, enabled) },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("count"),
+    .type = AZ_JSON_BIND_INT32,
+    .offset = offsetof(_az_json_bind_test_struct, count),
+    .required = true },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("limit"),
+    .type = AZ_JSON_BIND_UINT32,
+    .offset = offsetof(_az_json_bind_test_struct, limit) },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("timestamp"),
+    .type = AZ_JSON_BIND_INT64,
+    .offset = offsetof(_az_json_bind_test_struct, timestamp) },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("temperature"),
+    .type = AZ_JSON_BIND_DOUBLE,
+    .offset = offsetof(_az_json_bind_test_struct, temperature),
+    .fractional_digits = 2 },
+  { .name = AZ_SPAN_LITERAL_FROM_STR("name"),
+    .type = AZ_JSON_BIND_STRING,
+    .offset = offsetof(_az_json_bind_test_struct, name) },
+};
+
+static int32_t const _az_json_bind_test_fields_size
+    = sizeof(_az_json_bind_test_fields) / sizeof(_az_json_bind_test_fields[0]);
+
+static void test_json_bind(void** state)
+{
+  (void)state;
+
+  uint8_t name_buffer[16] = { 0 };
+  _az_json_bind_test_struct value = { .name = { .buffer = AZ_SPAN_FROM_BUFFER(name_buffer) } };
+
+  az_json_bind_table table = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_bind_table_init(&table, _az_json_bind_test_fields, _az_json_bind_test_fields_size));
+
+  // Unknown properties are skipped along with their nested values, and escaped names still match.
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(
+      &reader,
+      AZ_SPAN_FROM_STR("{\"unknown\":{\"count\":[1,2]},\"n\\u0061me\":\"th\\u00e9rmo\","
+                       "\"count\":-5,\"limit\":4000000000,\"timestamp\":-9000000000,"
+                       "\"temperature\":21.5,\"enabled\":true,\"other\":null}"),
+      NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_read(&reader, &table, &value));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+  assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+
+  assert_true(value.enabled);
+  assert_int_equal(value.count, -5);
+  assert_int_equal(value.limit, 4000000000U);
+  assert_true(value.timestamp == -9000000000LL);
+  assert_true(_is_double_equal(value.temperature, 21.5, 1e-9));
+  assert_true(az_span_is_content_equal(
+      az_span_slice(value.name.buffer, 0, value.name.length), AZ_SPAN_FROM_STR("th\xC3\xA9rmo")));
+
+  // The same table writes the struct back.
+  uint8_t json_buffer[256] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(json_buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_write(&writer, &table, &value));
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&writer),
+      AZ_SPAN_FROM_STR("{\"enabled\":true,\"count\":-5,\"limit\":4000000000,"
+                       "\"timestamp\":-9000000000,\"temperature\":21.5,"
+                       "\"name\":\"th\xC3\xA9rmo\"}")));
+
+  // Doubles are written with the given number of fractional digits, even none, or as short as they
+  // can be.
+  static az_json_bind_field const double_fields[] = {
+    { .name = AZ_SPAN_LITERAL_FROM_STR("fixed"),
+      .type = AZ_JSON_BIND_DOUBLE,
+      .offset = 0,
+      .fractional_digits = 0 },
+    { .name = AZ_SPAN_LITERAL_FROM_STR("shortest"),
+      .type = AZ_JSON_BIND_DOUBLE,
+      .offset = sizeof(double),
+      .fractional_digits = AZ_JSON_BIND_DOUBLE_SHORTEST },
+  };
+  double const doubles[2] = { 21.25, 21.25 };
+  az_json_bind_table double_table = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_bind_table_init(&double_table, double_fields, 2));
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(json_buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_write(&writer, &double_table, doubles));
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&writer),
+      AZ_SPAN_FROM_STR("{\"fixed\":21,\"shortest\":21.25}")));
+
+  // Members without a matching property are left unchanged, unless the field is required.
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"count\":7}"), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_read(&reader, &table, &value));
+  assert_int_equal(value.count, 7);
+  assert_int_equal(value.limit, 4000000000U);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"limit\":7}"), NULL));
+  assert_int_equal(
+      az_json_bind_read(&reader, &table, &value),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  // Values must match the type of their field, and the JSON value must be an object.
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"count\":\"7\"}"), NULL));
+  assert_int_equal(
+      az_json_bind_read(&reader, &table, &value),
+      AZ_ERROR_JSON_INVALID_STATE);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("[{\"count\":7}]"), NULL));
+  assert_int_equal(
+      az_json_bind_read(&reader, &table, &value),
+      AZ_ERROR_JSON_INVALID_STATE);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(
+      &reader, AZ_SPAN_FROM_STR("{\"count\":1,\"name\":\"longer than the buffer\"}"), NULL));
+  assert_int_equal(
+      az_json_bind_read(&reader, &table, &value),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // The buffer of a string member is kept, so a shorter string doesn't limit the next one.
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"count\":1,\"name\":\"ab\"}"), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_read(&reader, &table, &value));
+  assert_int_equal(value.name.length, 2);
+  TEST_EXPECT_SUCCESS(az_json_reader_init(
+      &reader, AZ_SPAN_FROM_STR("{\"count\":1,\"name\":\"fifteen chars!!\"}"), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_read(&reader, &table, &value));
+  assert_true(az_span_is_content_equal(
+      az_span_slice(value.name.buffer, 0, value.name.length), AZ_SPAN_FROM_STR("fifteen chars!!")));
+  assert_int_equal(az_span_size(value.name.buffer), 16);
+
+  // A string member without a buffer can't hold any string, not even an empty one.
+  _az_json_bind_test_struct empty_value = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"count\":1,\"name\":\"\"}"), NULL));
+  assert_int_equal(az_json_bind_read(&reader, &table, &empty_value), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // A table of the most fields there can be still finds each of them, whichever slot its name
+  // hashes to.
+  char field_names[32][4] = { { 0 } };
+  az_json_bind_field many_fields[32] = { { 0 } };
+  int32_t many_values[32] = { 0 };
+  for (int32_t i = 0; i < 32; i++)
+  {
+    az_span const field_name = AZ_SPAN_FROM_BUFFER(field_names[i]);
+    az_span remainder = AZ_SPAN_EMPTY;
+    TEST_EXPECT_SUCCESS(az_span_i32toa(az_span_copy_u8(field_name, 'f'), i, &remainder));
+
+    many_fields[i] = (az_json_bind_field){
+      .name = az_span_slice(field_name, 0, az_span_size(field_name) - az_span_size(remainder)),
+      .type = AZ_JSON_BIND_INT32,
+      .offset = i * (int32_t)sizeof(int32_t),
+    };
+    many_values[i] = i * 3;
+  }
+
+  az_json_bind_table many_table = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_bind_table_init(&many_table, many_fields, 32));
+
+  // A table can't have any more fields than that, or two fields with the same name.
+  az_json_bind_table invalid_table = { 0 };
+  az_json_bind_field too_many_fields[33] = { { 0 } };
+  for (int32_t i = 0; i < 33; i++)
+  {
+    too_many_fields[i] = many_fields[i % 32];
+  }
+  assert_int_equal(
+      az_json_bind_table_init(&invalid_table, too_many_fields, 33), AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_bind_table_init(&invalid_table, too_many_fields, 32));
+  too_many_fields[31] = many_fields[7];
+  assert_int_equal(az_json_bind_table_init(&invalid_table, too_many_fields, 32), AZ_ERROR_ARG);
+
+  uint8_t many_json_buffer[512] = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(many_json_buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_write(&writer, &many_table, many_values));
+
+  int32_t many_read_values[32] = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(
+      &reader, az_json_writer_get_bytes_used_in_destination(&writer), NULL));
+  TEST_EXPECT_SUCCESS(az_json_bind_read(&reader, &many_table, many_read_values));
+  for (int32_t i = 0; i < 32; i++)
+  {
+    assert_int_equal(many_read_values[i], i * 3);
+  }
+}
+
+/** Json Value **/
+static void test_json_value(void** state)
+{
+  (void)state;
+
+  az_json_token const json_boolean = (az_json_token){
+      .kind = AZ_JSON_TOKEN_TRUE,
+      .slice = AZ_SPAN_FROM_STR("true"),
+      ._internal = {
+        .string_has_escaped_chars = false,
+      },
+    };
+  az_json_token const json_number = (az_json_token){
+      .kind = AZ_JSON_TOKEN_NUMBER,
+      .slice = AZ_SPAN_FROM_STR("42"),
+      ._internal = {
+        .string_has_escaped_chars = false,
+      },
+    };
+  az_json_token const json_negative_number = (az_json_token){
+      .kind = AZ_JSON_TOKEN_NUMBER,
+      .slice = AZ_SPAN_FROM_STR("-42"),
+      ._internal = {
+        .string_has_escaped_chars = false,
+      },
+    };
+  az_json_token const json_decimal_number = (az_json_token){
+      .kind = AZ_JSON_TOKEN_NUMBER,
+      .slice = AZ_SPAN_FROM_STR("123.456"),
+      ._internal = {
+        .string_has_escaped_chars = false,
+      },
+    };
+  az_json_token const json_string = (az_json_token){
+      .kind = AZ_JSON_TOKEN_STRING,
+      .slice = AZ_SPAN_FROM_STR("Hello"),
+      ._internal = {
+        .string_has_escaped_chars = false,
+      },
+    };
+  az_json_token const json_property_name = (az_json_token){
+      .kind = AZ_JSON_TOKEN_PROPERTY_NAME,
+      .slice = AZ_SPAN_FROM_STR("Name"),
+      ._internal = {
+        .string_has_escaped_chars = false,
+      },
+    };
+
+  // boolean from boolean
+  {
+    bool boolean_value = false;
+    TEST_EXPECT_SUCCESS(az_json_token_get_boolean(&json_boolean, &boolean_value));
+    assert_true(boolean_value);
+  }
+  // boolean from number
+  {
+    bool boolean_value = false;
+    assert_true(
+        az_json_token_get_boolean(&json_number, &boolean_value) == AZ_ERROR_JSON_INVALID_STATE);
+  }
+  // unsigned number from negative number
+  {
+    uint32_t number_value_u32 = 0;
+    assert_int_equal(
+        az_json_token_get_uint32(&json_negative_number, &number_value_u32),
+        AZ_ERROR_UNEXPECTED_CHAR);
+    uint64_t number_value_u64 = 0;
+    assert_int_equal(
+        az_json_token_get_uint64(&json_negative_number, &number_value_u64),
+        AZ_ERROR_UNEXPECTED_CHAR);
+  }
+  // integer number from double number
+  {
+    uint32_t number_value_u32 = 0;
+    assert_int_equal(
+        az_json_token_get_uint32(&json_decimal_number, &number_value_u32),
+        AZ_ERROR_UNEXPECTED_CHAR);
+    uint64_t number_value_u64 = 0;
+    assert_int_equal(
+        az_json_token_get_uint64(&json_decimal_number, &number_value_u64),
+        AZ_ERROR_UNEXPECTED_CHAR);
+    int32_t number_value_i32 = 0;
+    assert_int_equal(
+        az_json_token_get_int32(&json_decimal_number, &number_value_i32), AZ_ERROR_UNEXPECTED_CHAR);
+    int64_t number_value_i64 = 0;
+    assert_int_equal(
+        az_json_token_get_int64(&json_decimal_number, &number_value_i64), AZ_ERROR_UNEXPECTED_CHAR);
+  }
+  // string from string
+  {
+    char string_value[10] = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_token_get_string(&json_string, string_value, 10, NULL));
+    assert_true(
+        az_span_is_content_equal(az_span_create_from_str(string_value), AZ_SPAN_FROM_STR("Hello")));
+
+    TEST_EXPECT_SUCCESS(az_json_token_get_string(&json_property_name, string_value, 10, NULL));
+    assert_true(
+        az_span_is_content_equal(az_span_create_from_str(string_value), AZ_SPAN_FROM_STR("Name")));
+  }
+  // string from boolean
+  {
+    char string_value[10] = { 0 };
+    assert_true(
+        az_json_token_get_string(&json_boolean, string_value, 10, NULL)
+        == AZ_ERROR_JSON_INVALID_STATE);
+  }
+  // number from number
+  {
+    uint64_t number_value = 1;
+    TEST_EXPECT_SUCCESS(az_json_token_get_uint64(&json_number, &number_value));
+
+    uint64_t const expected_value_bin_rep_view = 42;
+    assert_true(number_value == expected_value_bin_rep_view);
+  }
+  // double number from decimal and negative number
   {
     double number_value = 1;
     TEST_EXPECT_SUCCESS(az_json_token_get_double(&json_number, &number_value));
@@ -2151,6 +4190,54 @@ static void test_az_json_token_get_string_and_text_equal_discontiguous(void** st
   _az_JSON_TOKEN_IS_TEXT_EQUAL_NAME_HELPER(json_string);
 }
 
+static void test_az_json_token_get_string_and_text_equal_unicode_escapes(void** state)
+{
+  (void)state;
+
+  // A character from each UTF-8 encoding length, a surrogate pair, and unpaired surrogates.
+  az_span const json = AZ_SPAN_FROM_STR(
+      "\"a\\u0041\\u00e9\\u20AC\\uD83D\\uDE00\\uD800x\\uDC00\\uD800\\u0041\\t\"");
+  az_span const expected = AZ_SPAN_FROM_STR("aA\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"
+                                            "\xEF\xBF\xBDx\xEF\xBF\xBD\xEF\xBF\xBD"
+                                            "A\t");
+  int32_t const expected_size = az_span_size(expected);
+
+  // Every way of splitting the JSON in two, each escape sequence straddling the buffers.
+  for (int32_t split = 1; split < az_span_size(json); split++)
+  {
+    az_span buffers[2] = { az_span_slice(json, 0, split), az_span_slice_to_end(json, split) };
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers, 2, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+
+    char dest[64] = { 0 };
+    int32_t str_length = 0;
+    TEST_EXPECT_SUCCESS(az_json_token_get_string(&reader.token, dest, 64, &str_length));
+    assert_int_equal(str_length, expected_size);
+    assert_memory_equal(dest, az_span_ptr(expected), (size_t)expected_size);
+    assert_int_equal(dest[expected_size], 0);
+
+    assert_true(az_json_token_is_text_equal(&reader.token, expected));
+    assert_false(
+        az_json_token_is_text_equal(&reader.token, az_span_slice(expected, 0, expected_size - 1)));
+    assert_false(az_json_token_is_text_equal(&reader.token, az_span_slice_to_end(expected, 1)));
+
+    // The destination needs space for the null terminator.
+    assert_int_equal(
+        az_json_token_get_string(&reader.token, dest, expected_size, NULL),
+        AZ_ERROR_NOT_ENOUGH_SPACE);
+  }
+
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"\\u0048i\\ud83d\\ude00\":1}"), NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_true(az_json_token_is_text_equal(&reader.token, AZ_SPAN_FROM_STR("Hi\xF0\x9F\x98\x80")));
+  assert_false(az_json_token_is_text_equal(&reader.token, AZ_SPAN_FROM_STR("Hi")));
+}
+
 static az_span _az_buffers64_one[64] = { 0 };
 static uint8_t _az_buffer_for_complex_json[64] = { 0 };
 
@@ -2386,8 +4473,8 @@ static void test_az_json_token_number_too_large(void** state)
   uint64_t actual_u64 = 0;
   assert_int_equal(az_json_token_get_uint64(&json_number, &actual_u64), AZ_ERROR_UNEXPECTED_CHAR);
 
-  // double actual_d = 0;
-  // assert_int_equal(az_json_token_get_double(&json_number, &actual_d), AZ_ERROR_UNEXPECTED_CHAR);
+  double actual_d = 0;
+  assert_int_equal(az_json_token_get_double(&json_number, &actual_d), AZ_ERROR_UNEXPECTED_CHAR);
 
   az_span buffers_half[2] = { 0 };
   _az_split_buffers(json, buffers_half);
@@ -2402,7 +4489,7 @@ static void test_az_json_token_number_too_large(void** state)
   assert_int_equal(az_json_token_get_uint32(&json_number, &actual_u32), AZ_ERROR_UNEXPECTED_CHAR);
   assert_int_equal(az_json_token_get_int64(&json_number, &actual_i64), AZ_ERROR_UNEXPECTED_CHAR);
   assert_int_equal(az_json_token_get_uint64(&json_number, &actual_u64), AZ_ERROR_UNEXPECTED_CHAR);
-  // assert_int_equal(az_json_token_get_double(&json_number, &actual_d), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_json_token_get_double(&json_number, &actual_d), AZ_ERROR_UNEXPECTED_CHAR);
 }
 
 static void _az_json_token_literal_helper(az_span json, bool expected)
@@ -2822,27 +4909,103 @@ static void test_az_json_reader_chunked(void** state)
   assert_true(az_span_is_content_equal(expected, az_span_create_from_str(m.name_string)));
 }
 
+static void test_json_reader_long_strings_chunked(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      "[\"a long string which has no characters that need escaping, spanning 76 bytes.\","
+      "\"a long string with an escaped character: \\n, followed by more characters\"]");
+  az_span const first = AZ_SPAN_FROM_STR(
+      "a long string which has no characters that need escaping, spanning 76 bytes.");
+  az_span const second = AZ_SPAN_FROM_STR(
+      "a long string with an escaped character: \\n, followed by more characters");
+
+  // Split the JSON in two at every position, so that the end of the strings and the escaped
+  // character are found both within and across segment boundaries.
+  for (int32_t i = 1; i < az_span_size(json); i++)
+  {
+    az_span buffers[2] = { az_span_slice(json, 0, i), az_span_slice_to_end(json, i) };
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers, 2, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_BEGIN_ARRAY);
+
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+    assert_int_equal(reader.token.size, az_span_size(first));
+    assert_false(reader.token._internal.string_has_escaped_chars);
+    assert_true(az_json_token_is_text_equal(&reader.token, first));
+
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+    assert_int_equal(reader.token.size, az_span_size(second));
+    assert_true(reader.token._internal.string_has_escaped_chars);
+
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_ARRAY);
+  }
+
+  // A control character after a long run of valid characters is still rejected.
+  az_span const invalid
+      = AZ_SPAN_FROM_STR("[\"a long string which ends with a control character, that isn't "
+                         "escaped\x1F\"]");
+  for (int32_t i = 1; i < az_span_size(invalid); i++)
+  {
+    az_span buffers[2] = { az_span_slice(invalid, 0, i), az_span_slice_to_end(invalid, i) };
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers, 2, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+  }
+}
+
 int test_az_json()
 {
   const struct CMUnitTest tests[]
       = { cmocka_unit_test(test_json_reader_init),
           cmocka_unit_test(test_json_writer),
+          cmocka_unit_test(test_json_writer_append_double_shortest),
+          cmocka_unit_test(test_json_writer_append_int64),
+          cmocka_unit_test(test_json_writer_escape_runs),
+          cmocka_unit_test(test_json_writer_prepared_property_name),
           cmocka_unit_test(test_json_writer_append_nested),
           cmocka_unit_test(test_json_writer_append_nested_invalid),
           cmocka_unit_test(test_json_writer_chunked),
           cmocka_unit_test(test_json_writer_chunked_no_callback),
           cmocka_unit_test(test_json_writer_large_string_chunked),
+          cmocka_unit_test(test_json_writer_pooled),
+          cmocka_unit_test(test_json_writer_checkpoint_and_flush),
+          cmocka_unit_test(test_json_writer_sizing),
           cmocka_unit_test(test_json_reader),
           cmocka_unit_test(test_json_reader_invalid),
           cmocka_unit_test(test_json_reader_incomplete),
           cmocka_unit_test(test_json_skip_children),
+          cmocka_unit_test(test_json_skip_children_without_validation),
+          cmocka_unit_test(test_json_reader_find_paths),
+          cmocka_unit_test(test_json_reader_cursor),
+          cmocka_unit_test(test_json_document),
+          cmocka_unit_test(test_json_push_reader),
+          cmocka_unit_test(test_json_validate_utf8),
+          cmocka_unit_test(test_json_reader_capture_number_values),
+          cmocka_unit_test(test_json_reader_capture_fractional_numbers),
+          cmocka_unit_test(test_json_bind),
+          cmocka_unit_test(test_json_template),
+          cmocka_unit_test(test_json_transform),
+          cmocka_unit_test(test_json_merge_patch),
+          cmocka_unit_test(test_json_array_split),
+          cmocka_unit_test(test_json_lines_reader),
           cmocka_unit_test(test_json_value),
           cmocka_unit_test(test_az_json_token_get_string_and_text_equal),
           cmocka_unit_test(test_az_json_token_get_string_and_text_equal_discontiguous),
+          cmocka_unit_test(test_az_json_token_get_string_and_text_equal_unicode_escapes),
           cmocka_unit_test(test_az_json_reader_double),
           cmocka_unit_test(test_az_json_token_number_too_large),
           cmocka_unit_test(test_az_json_token_literal),
           cmocka_unit_test(test_az_json_token_copy),
-          cmocka_unit_test(test_az_json_reader_chunked) };
+          cmocka_unit_test(test_az_json_reader_chunked),
+          cmocka_unit_test(test_json_reader_long_strings_chunked) };
   return cmocka_run_group_tests_name("az_core_json", tests, NULL, NULL);
 }
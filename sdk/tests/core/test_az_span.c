@@ -352,6 +352,68 @@ static void az_span_atoi64_test(void** state)
       az_span_atoi64(AZ_SPAN_FROM_STR("-9223372036854775809"), &value), AZ_ERROR_UNEXPECTED_CHAR);
 }
 
+static void az_span_ato_integer_long_digit_runs(void** state)
+{
+  (void)state;
+  uint64_t u64 = 0;
+  uint32_t u32 = 0;
+  int64_t i64 = 0;
+  int32_t i32 = 0;
+
+  // Digits are converted 8 at a time, so check numbers of every length around multiples of 8, and
+  // long runs of leading zeros.
+  assert_int_equal(az_span_atou64(AZ_SPAN_FROM_STR("12345678"), &u64), AZ_OK);
+  assert_int_equal(u64, 12345678);
+  assert_int_equal(az_span_atou64(AZ_SPAN_FROM_STR("123456789"), &u64), AZ_OK);
+  assert_int_equal(u64, 123456789);
+  assert_int_equal(az_span_atou64(AZ_SPAN_FROM_STR("9876543210987654"), &u64), AZ_OK);
+  assert_int_equal(u64, 9876543210987654);
+  assert_int_equal(az_span_atou64(AZ_SPAN_FROM_STR("9999999999999999999"), &u64), AZ_OK);
+  assert_int_equal(u64, 9999999999999999999ULL);
+  assert_int_equal(
+      az_span_atou64(AZ_SPAN_FROM_STR("0000000000000000000000000018446744073709551615"), &u64),
+      AZ_OK);
+  assert_int_equal(u64, UINT64_MAX);
+  assert_int_equal(
+      az_span_atou64(AZ_SPAN_FROM_STR("+00000000000000000000000000000000"), &u64), AZ_OK);
+  assert_int_equal(u64, 0);
+  assert_int_equal(az_span_atou32(AZ_SPAN_FROM_STR("000000000004294967295"), &u32), AZ_OK);
+  assert_int_equal(u32, UINT32_MAX);
+  assert_int_equal(az_span_atoi32(AZ_SPAN_FROM_STR("-000000002147483648"), &i32), AZ_OK);
+  assert_int_equal(i32, INT32_MIN);
+  assert_int_equal(az_span_atoi64(AZ_SPAN_FROM_STR("-1234567812345678"), &i64), AZ_OK);
+  assert_int_equal(i64, -1234567812345678);
+
+  assert_int_equal(
+      az_span_atou64(AZ_SPAN_FROM_STR("00000000000000000000000000018446744073709551616"), &u64),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_span_atou64(AZ_SPAN_FROM_STR("99999999999999999999"), &u64), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_span_atou64(AZ_SPAN_FROM_STR("100000000000000000000"), &u64), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_span_atou32(AZ_SPAN_FROM_STR("00000000004294967296"), &u32), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_span_atoi32(AZ_SPAN_FROM_STR("-00000002147483649"), &i32), AZ_ERROR_UNEXPECTED_CHAR);
+
+  // A byte which isn't a digit is found wherever it is within a group of 8 digits, including the
+  // bytes just around '0' and '9'.
+  uint8_t digits[16];
+  uint8_t const invalid_bytes[] = { '/', ':', ' ', '.', 'a', 0, 0x80, 0xB0 };
+  for (int32_t i = 0; i < (int32_t)sizeof(digits); i++)
+  {
+    for (size_t j = 0; j < sizeof(invalid_bytes); j++)
+    {
+      memcpy(digits, "1234567890123456", sizeof(digits));
+      digits[i] = invalid_bytes[j];
+      assert_int_equal(
+          az_span_atou64(AZ_SPAN_FROM_BUFFER(digits), &u64), AZ_ERROR_UNEXPECTED_CHAR);
+      assert_int_equal(
+          az_span_atoi64(AZ_SPAN_FROM_BUFFER(digits), &i64), AZ_ERROR_UNEXPECTED_CHAR);
+    }
+  }
+}
+
 #define TEST_AZ_ISFINITE_HELPER(source, expected)      \
   do                                                   \
   {                                                    \
@@ -500,6 +562,12 @@ static void az_span_atod_test(void** state)
   assert_true(value == 00100.001);
   assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("00100.00100"), &value), AZ_OK);
   assert_true(value == 00100.00100);
+  assert_int_equal(
+      az_span_atod(AZ_SPAN_FROM_STR("0000000000000000123456789.12345678901"), &value), AZ_OK);
+  assert_true(value == 123456789.12345678901);
+  assert_int_equal(
+      az_span_atod(AZ_SPAN_FROM_STR("0.00000000000000001234567890123456789"), &value), AZ_OK);
+  assert_true(value == 0.00000000000000001234567890123456789);
   assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0.001"), &value), AZ_OK);
   assert_true(value == 0.001);
   assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0.0012"), &value), AZ_OK);
@@ -638,6 +706,71 @@ static void az_span_atod_test(void** state)
   assert_true(value == 0);
 }
 
+static void az_span_atod_correctly_rounded(void** state)
+{
+  (void)state;
+  double value = 0;
+
+  // Numbers that are exactly halfway between two doubles round to the even one.
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("9007199254740993"), &value), AZ_OK);
+  assert_true(value == 9007199254740992.0);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("9007199254740995"), &value), AZ_OK);
+  assert_true(value == 9007199254740996.0);
+
+  // More than 19 significant digits, where the digits beyond the 19th decide the rounding.
+  assert_int_equal(
+      az_span_atod(AZ_SPAN_FROM_STR("9007199254740993.0000000000000000001"), &value), AZ_OK);
+  assert_true(value == 9007199254740994.0);
+  assert_int_equal(
+      az_span_atod(
+          AZ_SPAN_FROM_STR("2.4703282292062327208828439643411068618252990130716238221279284125033"
+                           "77536351043759326499181e-324"),
+          &value),
+      AZ_OK);
+  assert_true(value == 0);
+  assert_int_equal(
+      az_span_atod(
+          AZ_SPAN_FROM_STR("2.4703282292062327208828439643411068618252990130716238221279284125033"
+                           "77536351043759326499182e-324"),
+          &value),
+      AZ_OK);
+  assert_true(value == 4.9406564584124654e-324);
+
+  // Boundaries of the range of doubles.
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("4.9406564584124654e-324"), &value), AZ_OK);
+  assert_true(value == 4.9406564584124654e-324);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("2.2250738585072011e-308"), &value), AZ_OK);
+  assert_true(value == 2.2250738585072011e-308);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("2.2250738585072014e-308"), &value), AZ_OK);
+  assert_true(value == 2.2250738585072014e-308);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1.7976931348623157e308"), &value), AZ_OK);
+  assert_true(value == 1.7976931348623157e308);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1.7976931348623158e308"), &value), AZ_OK);
+  assert_true(value == 1.7976931348623157e308);
+  assert_int_equal(
+      az_span_atod(AZ_SPAN_FROM_STR("1.7976931348623159e308"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e23"), &value), AZ_OK);
+  assert_true(value == 1e23);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0.1"), &value), AZ_OK);
+  assert_true(value == 0.1);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("-.5"), &value), AZ_OK);
+  assert_true(value == -0.5);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1E+2"), &value), AZ_OK);
+  assert_true(value == 100);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0e99999999999"), &value), AZ_OK);
+  assert_true(value == 0);
+
+  // Anything other than a decimal number is rejected, including hexadecimal floating point.
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0x10"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e+"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1.2.3"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("-."), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1 "), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e5x"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+}
+
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif // __GNUC__
@@ -985,6 +1118,62 @@ static void az_span_i64toa_negative_number_test(void** state)
   assert_int_equal(reverse, number);
 }
 
+static void az_span_u64toa_every_digit_count(void** state)
+{
+  (void)state;
+  uint8_t buffer[_az_MAX_SIZE_FOR_UINT64];
+  uint8_t expected[_az_MAX_SIZE_FOR_UINT64];
+  az_span remainder;
+
+  // For every number of digits n, check 10^(n-1), which is 1 followed by zeros, and 10^n - 1, which
+  // is all nines.
+  uint64_t power_of_ten = 1;
+  for (int32_t digit_count = 1; digit_count <= _az_MAX_SIZE_FOR_UINT64; digit_count++)
+  {
+    az_span const expected_span = az_span_create(expected, digit_count);
+
+    az_span_fill(expected_span, '0');
+    expected[0] = '1';
+    assert_int_equal(_az_span_u64toa_size(power_of_ten), digit_count);
+    assert_int_equal(az_span_u64toa(AZ_SPAN_FROM_BUFFER(buffer), power_of_ten, &remainder), AZ_OK);
+    assert_int_equal(az_span_size(remainder), _az_MAX_SIZE_FOR_UINT64 - digit_count);
+    assert_memory_equal(buffer, expected, (size_t)digit_count);
+
+    if (digit_count < _az_MAX_SIZE_FOR_UINT64)
+    {
+      uint64_t const all_nines = power_of_ten * 10 - 1;
+      az_span_fill(expected_span, '9');
+      assert_int_equal(_az_span_u64toa_size(all_nines), digit_count);
+      assert_int_equal(az_span_u64toa(AZ_SPAN_FROM_BUFFER(buffer), all_nines, &remainder), AZ_OK);
+      assert_memory_equal(buffer, expected, (size_t)digit_count);
+    }
+
+    // One byte less than needed isn't enough.
+    assert_int_equal(
+        az_span_u64toa(az_span_create(buffer, digit_count - 1), power_of_ten, &remainder),
+        AZ_ERROR_NOT_ENOUGH_SPACE);
+
+    if (digit_count < _az_MAX_SIZE_FOR_UINT64)
+    {
+      power_of_ten *= 10;
+    }
+  }
+
+  assert_int_equal(_az_span_u64toa_size(0), 1);
+  assert_int_equal(_az_span_u64toa_size(UINT64_MAX), _az_MAX_SIZE_FOR_UINT64);
+  assert_int_equal(az_span_u64toa(AZ_SPAN_FROM_BUFFER(buffer), UINT64_MAX, &remainder), AZ_OK);
+  assert_memory_equal(buffer, "18446744073709551615", _az_MAX_SIZE_FOR_UINT64);
+
+  uint8_t signed_buffer[_az_MAX_SIZE_FOR_INT64];
+  assert_int_equal(
+      az_span_i64toa(AZ_SPAN_FROM_BUFFER(signed_buffer), INT64_MIN, &remainder), AZ_OK);
+  assert_memory_equal(signed_buffer, "-9223372036854775808", _az_MAX_SIZE_FOR_INT64);
+  assert_int_equal(
+      az_span_i32toa(AZ_SPAN_FROM_BUFFER(signed_buffer), INT32_MIN, &remainder), AZ_OK);
+  assert_int_equal(az_span_size(remainder), _az_MAX_SIZE_FOR_INT64 - _az_MAX_SIZE_FOR_INT32);
+  assert_memory_equal(signed_buffer, "-2147483648", _az_MAX_SIZE_FOR_INT32);
+}
+
 static void az_span_slice_to_end_test(void** state)
 {
   (void)state;
@@ -1493,6 +1682,99 @@ static void az_span_dtoa_too_large(void** state)
   assert_int_equal(az_span_dtoa(buff, 1.7e308, 15, &o), AZ_ERROR_NOT_SUPPORTED);
 }
 
+#define AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(v, expected)                                   \
+  do                                                                                       \
+  {                                                                                        \
+    az_span buffer = AZ_SPAN_FROM_BUFFER(raw_buffer);                                      \
+    az_span out_span = AZ_SPAN_EMPTY;                                                      \
+    assert_true(az_result_succeeded(az_span_dtoa_shortest(buffer, v, &out_span)));         \
+    az_span output = az_span_slice(buffer, 0, _az_span_diff(out_span, buffer));            \
+    assert_true(az_span_is_content_equal(output, expected));                               \
+    double round_trip = 0;                                                                 \
+    assert_true(az_result_succeeded(az_span_atod(output, &round_trip)));                   \
+    double const original = v;                                                             \
+    assert_memory_equal(&round_trip, &original, sizeof(double));                           \
+  } while (0)
+
+static void az_span_dtoa_shortest_succeeds(void** state)
+{
+  (void)state;
+
+  // [-]0.00000[0-9]{17}, i.e. 1+2+5+17
+  uint8_t raw_buffer[25] = { 0 };
+
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(0.0, AZ_SPAN_FROM_STR("0"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(-0.0, AZ_SPAN_FROM_STR("-0"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1.0, AZ_SPAN_FROM_STR("1"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(-1.5, AZ_SPAN_FROM_STR("-1.5"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(12345, AZ_SPAN_FROM_STR("12345"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(0.1, AZ_SPAN_FROM_STR("0.1"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(0.3, AZ_SPAN_FROM_STR("0.3"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(0.1 + 0.2, AZ_SPAN_FROM_STR("0.30000000000000004"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(123.123, AZ_SPAN_FROM_STR("123.123"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(-9876.54321, AZ_SPAN_FROM_STR("-9876.54321"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1e-6, AZ_SPAN_FROM_STR("0.000001"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(
+      -1.2345678901234567e-6, AZ_SPAN_FROM_STR("-0.0000012345678901234567"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1e-7, AZ_SPAN_FROM_STR("1e-7"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1.5e-7, AZ_SPAN_FROM_STR("1.5e-7"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1e20, AZ_SPAN_FROM_STR("100000000000000000000"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1e21, AZ_SPAN_FROM_STR("1e+21"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(
+      123456789012345678901.0, AZ_SPAN_FROM_STR("123456789012345680000"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(9007199254740993.0, AZ_SPAN_FROM_STR("9007199254740992"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(1e300, AZ_SPAN_FROM_STR("1e+300"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(
+      1.7976931348623157e308, AZ_SPAN_FROM_STR("1.7976931348623157e+308"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(
+      -2.2250738585072014e-308, AZ_SPAN_FROM_STR("-2.2250738585072014e-308"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(5e-324, AZ_SPAN_FROM_STR("5e-324"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(2.5e-323, AZ_SPAN_FROM_STR("2.5e-323"));
+
+  // Powers of two, where the interval of values rounding to the double isn't symmetric.
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(
+      9007199254740992.0 * 2, AZ_SPAN_FROM_STR("18014398509481984"));
+  AZ_SPAN_DTOA_SHORTEST_SUCCEEDS_HELPER(
+      2.2250738585072014e-308 * 1024, AZ_SPAN_FROM_STR("2.2784756311113742e-305"));
+}
+
+static void az_span_dtoa_shortest_overflow_fails(void** state)
+{
+  (void)state;
+
+  uint8_t raw_buffer[25];
+  az_span buff = AZ_SPAN_FROM_BUFFER(raw_buffer);
+  az_span o;
+
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 0), 0, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 1), -0.0, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 4), 12345, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 2), 0.1, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 7), 1e-6, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 20), 1e20, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 5), 1e300, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 23), -1.7976931348623157e308, &o),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // The output isn't written partially.
+  raw_buffer[0] = 'x';
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 3), -1.5, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(raw_buffer[0], 'x');
+
+  assert_int_equal(
+      az_span_dtoa_shortest(az_span_slice(buff, 0, 24), -1.7976931348623157e308, &o), AZ_OK);
+  assert_int_equal(az_span_size(o), 0);
+}
+
 static void az_span_copy_empty(void** state)
 {
   (void)state;
@@ -1776,13 +2058,16 @@ int test_az_span()
     cmocka_unit_test(az_span_atoi32_test),
     cmocka_unit_test(az_span_atou64_test),
     cmocka_unit_test(az_span_atoi64_test),
+    cmocka_unit_test(az_span_ato_integer_long_digit_runs),
     cmocka_unit_test(test_az_isfinite),
     cmocka_unit_test(az_span_atod_test),
+    cmocka_unit_test(az_span_atod_correctly_rounded),
     cmocka_unit_test(az_span_atod_non_finite_not_allowed),
     cmocka_unit_test(az_span_ato_number_whitespace_or_invalid_not_allowed),
     cmocka_unit_test(az_span_ato_number_no_out_of_bounds_reads),
     cmocka_unit_test(az_span_i64toa_negative_number_test),
     cmocka_unit_test(az_span_i64toa_test),
+    cmocka_unit_test(az_span_u64toa_every_digit_count),
     cmocka_unit_test(az_span_test_macro_only_allows_byte_buffers),
     cmocka_unit_test(az_span_create_from_str_succeeds),
     cmocka_unit_test(az_span_copy_uint8_succeeds),
@@ -1798,6 +2083,8 @@ int test_az_span()
     cmocka_unit_test(az_span_dtoa_succeeds),
     cmocka_unit_test(az_span_dtoa_overflow_fails),
     cmocka_unit_test(az_span_dtoa_too_large),
+    cmocka_unit_test(az_span_dtoa_shortest_succeeds),
+    cmocka_unit_test(az_span_dtoa_shortest_overflow_fails),
     cmocka_unit_test(az_span_copy_empty),
     cmocka_unit_test(test_az_span_is_valid),
     cmocka_unit_test(test_az_span_overlap),